@@ -1,3 +1,6 @@
+import os
+import struct
+
 import streamlit as st
 import pandas as pd
 import plotly.express as px
@@ -6,66 +9,207 @@ import numpy as np
 # --- Configuration ---
 st.set_page_config(layout="wide", page_title="Dynamic Hash Table Analyzer")
 
-# Column Definitions for robust CSV loading
-ALL_COLS = [
-    'Key_Index', 'Load_Factor', 'Scale', 'Distribution',
-    'Chaining_Probes', 'Linear_Probing_Probes', 'Quadratic_Probing_Probes', 'Double_Hashing_Probes',
-    'Chaining_Time_ms', 'Linear_Probing_Time_ms', 'Quadratic_Probing_Time_ms', 'Double_Hashing_Time_ms'
-]
-
-PROBE_COLS = [
-    'Chaining_Probes', 'Linear_Probing_Probes', 'Quadratic_Probing_Probes', 'Double_Hashing_Probes'
-]
+# Techniques emitted by the C engine (CSV column prefix -> display name).
+# Must stay in sync with technique_names[] in hash_table_analyzer.c.
+TECHNIQUES = {
+    'Chaining': 'Separate Chaining',
+    'Linear_Probing': 'Linear Probing',
+    'Quadratic_Probing': 'Quadratic Probing',
+    'Double_Hashing': 'Double Hashing',
+    'Meta_Probing': 'Metadata Probing (Swiss-style)',
+    'SIMD_Probing': 'SIMD Linear Probing',
+    'Robin_Hood': 'Robin Hood Hashing',
+    'Cuckoo': 'Cuckoo Hashing',
+    'Prefetch_Chaining': 'Prefetch Chaining',
+    'Cell_Chaining': 'Cell-Packed Chaining',
+    'Batched_Probing': 'Batched Linear Probing',
+    'Triangular_Probing': 'Triangular Quadratic Probing',
+}
 
-TIME_COLS = [
-    'Chaining_Time_ms', 'Linear_Probing_Time_ms', 'Quadratic_Probing_Time_ms', 'Double_Hashing_Time_ms'
-]
+# Column Definitions for robust CSV loading, derived from the technique
+# list so schema changes only happen in one place. Column groups appear
+# in the same order the C engine emits them.
+PROBE_COLS = [f'{t}_Probes' for t in TECHNIQUES]
+TIME_COLS = [f'{t}_Time_ms' for t in TECHNIQUES]
+NS_PER_OP_COLS = [f'{t}_ns_per_op' for t in TECHNIQUES]
+NS_MEDIAN_COLS = [f'{t}_ns_per_op_Median' for t in TECHNIQUES]
+NS_P99_COLS = [f'{t}_ns_per_op_P99' for t in TECHNIQUES]
+NS_STDDEV_COLS = [f'{t}_ns_per_op_Stddev' for t in TECHNIQUES]
+PROBE_MAX_COLS = [f'{t}_Probe_Max' for t in TECHNIQUES]
+PROBE_VAR_COLS = [f'{t}_Probe_Var' for t in TECHNIQUES]
+LOOKUP_PROBE_COLS = [f'{t}_Lookup_Probes' for t in TECHNIQUES]
+LOOKUP_TIME_COLS = [f'{t}_Lookup_Time_ms' for t in TECHNIQUES]
+MISS_PROBE_AVG_COLS = [f'{t}_Miss_Probes_Avg' for t in TECHNIQUES]
+MISS_PROBE_MAX_COLS = [f'{t}_Miss_Probes_Max' for t in TECHNIQUES]
+MISS_NS_COLS = [f'{t}_Miss_ns_per_op' for t in TECHNIQUES]
+DELETE_PROBE_COLS = [f'{t}_Delete_Probes' for t in TECHNIQUES]
+DELETE_TIME_COLS = [f'{t}_Delete_Time_ms' for t in TECHNIQUES]
+MIGRATION_PROBE_COLS = [f'{t}_Migration_Probes' for t in TECHNIQUES]
+MIGRATION_TIME_COLS = [f'{t}_Migration_Time_ms' for t in TECHNIQUES]
+INSERT_FAILURE_COLS = [f'{t}_Insert_Failures' for t in TECHNIQUES]
+STASH_HIT_COLS = [f'{t}_Stash_Hits' for t in TECHNIQUES]
+MEM_BYTES_COLS = [f'{t}_Mem_Bytes' for t in TECHNIQUES]
+MEM_OVERHEAD_COLS = [f'{t}_Mem_Overhead' for t in TECHNIQUES]
+BYTES_PER_KEY_COLS = [f'{t}_Bytes_Per_Key' for t in TECHNIQUES]
+L1_MISS_COLS = [f'{t}_L1_Misses' for t in TECHNIQUES]
+LLC_MISS_COLS = [f'{t}_LLC_Misses' for t in TECHNIQUES]
+BRANCH_MISS_COLS = [f'{t}_Branch_Misses' for t in TECHNIQUES]
+CYCLE_COLS = [f'{t}_Cycles' for t in TECHNIQUES]
+
+ALL_COLS = (['Key_Index', 'Load_Factor', 'Scale', 'Distribution']
+            + PROBE_COLS + TIME_COLS + NS_PER_OP_COLS
+            + NS_MEDIAN_COLS + NS_P99_COLS + NS_STDDEV_COLS
+            + PROBE_MAX_COLS + PROBE_VAR_COLS
+            + LOOKUP_PROBE_COLS + LOOKUP_TIME_COLS
+            + MISS_PROBE_AVG_COLS + MISS_PROBE_MAX_COLS + MISS_NS_COLS
+            + DELETE_PROBE_COLS + DELETE_TIME_COLS
+            + MIGRATION_PROBE_COLS + MIGRATION_TIME_COLS
+            + INSERT_FAILURE_COLS + STASH_HIT_COLS
+            + MEM_BYTES_COLS + MEM_OVERHEAD_COLS + BYTES_PER_KEY_COLS
+            + L1_MISS_COLS + LLC_MISS_COLS + BRANCH_MISS_COLS + CYCLE_COLS
+            + ['Page_Mode'])
+
+# Metric groups offered in the sidebar; lookup/delete columns are only
+# populated by --workload runs, migration columns by --grow-at runs, and
+# hardware counter columns by --perf runs on Linux.
+METRIC_GROUPS = {
+    'Total Probes': PROBE_COLS,
+    'Insertion Time (ms)': TIME_COLS,
+    'Insert ns/op': NS_PER_OP_COLS,
+    'Insert ns/op (median)': NS_MEDIAN_COLS,
+    'Insert ns/op (p99)': NS_P99_COLS,
+    'Insert ns/op (stddev)': NS_STDDEV_COLS,
+    'Probe Max (window)': PROBE_MAX_COLS,
+    'Probe Variance (window)': PROBE_VAR_COLS,
+    'Lookup Probes': LOOKUP_PROBE_COLS,
+    'Failed Lookup Probes (avg)': MISS_PROBE_AVG_COLS,
+    'Failed Lookup Probes (max)': MISS_PROBE_MAX_COLS,
+    'Failed Lookup ns/op': MISS_NS_COLS,
+    'Delete Probes': DELETE_PROBE_COLS,
+    'Migration Probes': MIGRATION_PROBE_COLS,
+    'Insert Failures': INSERT_FAILURE_COLS,
+    'Stash Hits': STASH_HIT_COLS,
+    'Memory Bytes': MEM_BYTES_COLS,
+    'Memory Overhead': MEM_OVERHEAD_COLS,
+    'Bytes per Key': BYTES_PER_KEY_COLS,
+    'L1 Misses': L1_MISS_COLS,
+    'LLC Misses': LLC_MISS_COLS,
+    'Branch Misses': BRANCH_MISS_COLS,
+    'Cycles': CYCLE_COLS,
+}
 
 # Mapping technique names for display
-TECHNIQUE_MAP = {
-    'Chaining_Probes': 'Separate Chaining',
-    'Linear_Probing_Probes': 'Linear Probing',
-    'Quadratic_Probing_Probes': 'Quadratic Probing',
-    'Double_Hashing_Probes': 'Double Hashing',
-    'Chaining_Time_ms': 'Separate Chaining',
-    'Linear_Probing_Time_ms': 'Linear Probing',
-    'Quadratic_Probing_Time_ms': 'Quadratic Probing',
-    'Double_Hashing_Time_ms': 'Double Hashing',
-}
+TECHNIQUE_MAP = {}
+for cols in (PROBE_COLS, TIME_COLS, NS_PER_OP_COLS,
+             NS_MEDIAN_COLS, NS_P99_COLS, NS_STDDEV_COLS,
+             PROBE_MAX_COLS, PROBE_VAR_COLS,
+             LOOKUP_PROBE_COLS, LOOKUP_TIME_COLS,
+             MISS_PROBE_AVG_COLS, MISS_PROBE_MAX_COLS, MISS_NS_COLS,
+             DELETE_PROBE_COLS, DELETE_TIME_COLS,
+             MIGRATION_PROBE_COLS, MIGRATION_TIME_COLS,
+             INSERT_FAILURE_COLS, STASH_HIT_COLS,
+             MEM_BYTES_COLS, MEM_OVERHEAD_COLS, BYTES_PER_KEY_COLS,
+             L1_MISS_COLS, LLC_MISS_COLS, BRANCH_MISS_COLS, CYCLE_COLS):
+    for t, name in zip(TECHNIQUES, cols):
+        TECHNIQUE_MAP[name] = TECHNIQUES[t]
+
+# Packed binary format written by the C engine with --binary-out
+# (see BinHeader/BinRecord in hash_table_analyzer.c). Memory-mapped, so
+# large sweeps load without a CSV parse.
+BINARY_PATH = 'results_data.bin'
+CONCURRENT_PATH = 'concurrent_data.csv'
+HIST_PATH = 'probe_hist.csv'
+# Live ring written by `./analyzer --shm-out /hash_analyzer_live`
+# (see ShmHeader/ShmRecord in hash_table_analyzer.c).
+SHM_LIVE_PATH = '/dev/shm/hash_analyzer_live'
+SHM_MAGIC = b'HTLV'
+BIN_MAGIC = b'HTBR'
+BIN_NAME_LEN = 32
+
+
+def load_binary_frame(path):
+    """Memory-maps a --binary-out file into a wide DataFrame."""
+    with open(path, 'rb') as f:
+        magic, version, num_techniques, record_size = struct.unpack('<4sIII', f.read(16))
+        if magic != BIN_MAGIC:
+            raise ValueError(f'{path} is not an analyzer binary output file')
+        names = [
+            f.read(BIN_NAME_LEN).split(b'\0')[0].decode()
+            for _ in range(num_techniques)
+        ]
+
+    dtype = np.dtype(
+        [('Key_Index', '<i8'), ('Load_Factor', '<f8'),
+         ('Scale', 'S16'), ('Distribution', 'S16')]
+        + [(f'{n}_Probes', '<i8') for n in names]
+        + [(f'{n}_Time_ms', '<f8') for n in names]
+        + [(f'{n}_ns_per_op', '<f8') for n in names]
+        + [(f'{n}_ns_per_op_Median', '<f8') for n in names]
+        + [(f'{n}_ns_per_op_P99', '<f8') for n in names]
+        + [(f'{n}_ns_per_op_Stddev', '<f8') for n in names]
+        + [(f'{n}_Probe_Max', '<i8') for n in names]
+        + [(f'{n}_Probe_Var', '<f8') for n in names]
+        + [(f'{n}_Lookup_Probes', '<i8') for n in names]
+        + [(f'{n}_Lookup_Time_ms', '<f8') for n in names]
+        + [(f'{n}_Miss_Probes_Avg', '<f8') for n in names]
+        + [(f'{n}_Miss_Probes_Max', '<i8') for n in names]
+        + [(f'{n}_Miss_ns_per_op', '<f8') for n in names]
+        + [(f'{n}_Delete_Probes', '<i8') for n in names]
+        + [(f'{n}_Delete_Time_ms', '<f8') for n in names]
+        + [(f'{n}_Migration_Probes', '<i8') for n in names]
+        + [(f'{n}_Migration_Time_ms', '<f8') for n in names]
+        + [(f'{n}_Insert_Failures', '<i8') for n in names]
+        + [(f'{n}_Stash_Hits', '<i8') for n in names]
+        + [(f'{n}_Mem_Bytes', '<i8') for n in names]
+        + [(f'{n}_Mem_Overhead', '<i8') for n in names]
+        + [(f'{n}_Bytes_Per_Key', '<f8') for n in names]
+        + [(f'{n}_L1_Misses', '<i8') for n in names]
+        + [(f'{n}_LLC_Misses', '<i8') for n in names]
+        + [(f'{n}_Branch_Misses', '<i8') for n in names]
+        + [(f'{n}_Cycles', '<i8') for n in names]
+        + [('Page_Mode', 'S16')]
+    )
+    if dtype.itemsize != record_size:
+        raise ValueError(f'{path}: record size {record_size} does not match expected {dtype.itemsize}')
+
+    offset = 16 + BIN_NAME_LEN * num_techniques
+    records = np.memmap(path, dtype=dtype, mode='r', offset=offset)
+    df = pd.DataFrame.from_records(records)
+    for col in ('Scale', 'Distribution', 'Page_Mode'):
+        df[col] = df[col].str.decode('ascii')
+    return df
+
 
 @st.cache_data
 def load_data():
-    """Loads and reshapes the CSV data into a long format for plotting."""
+    """Loads and reshapes the simulation data into a long format for plotting."""
     try:
-        # Load data, skipping header and assigning column names explicitly
-        df = pd.read_csv(
-            'results_data.csv',
-            header=None,
-            names=ALL_COLS,
-            skiprows=1  # Skip the first row (the original header)
-        )
+        if os.path.exists(BINARY_PATH):
+            df = load_binary_frame(BINARY_PATH)
+        else:
+            # Load data, skipping header and assigning column names explicitly
+            df = pd.read_csv(
+                'results_data.csv',
+                header=None,
+                names=ALL_COLS,
+                skiprows=1  # Skip the first row (the original header)
+            )
     except Exception as e:
-        st.error(f"Error loading CSV data: {e}")
+        st.error(f"Error loading simulation data: {e}")
         st.stop()
 
-    # --- Reshape Probe Data ---
-    df_probes = df.melt(
-        id_vars=['Scale', 'Distribution', 'Load_Factor', 'Key_Index'],
-        value_vars=PROBE_COLS,
-        var_name='Technique_Raw',
-        value_name='Metric_Value'
-    ).assign(Metric_Type='Total Probes')
-
-    # --- Reshape Timing Data ---
-    df_time = df.melt(
-        id_vars=['Scale', 'Distribution', 'Load_Factor', 'Key_Index'],
-        value_vars=TIME_COLS,
-        var_name='Technique_Raw',
-        value_name='Metric_Value'
-    ).assign(Metric_Type='Insertion Time (ms)')
+    # --- Reshape each metric group into long format ---
+    melted = []
+    for metric_type, cols in METRIC_GROUPS.items():
+        melted.append(df.melt(
+            id_vars=['Scale', 'Distribution', 'Load_Factor', 'Key_Index', 'Page_Mode'],
+            value_vars=cols,
+            var_name='Technique_Raw',
+            value_name='Metric_Value'
+        ).assign(Metric_Type=metric_type))
 
     # Combine data frames
-    df_long = pd.concat([df_probes, df_time], ignore_index=True)
+    df_long = pd.concat(melted, ignore_index=True)
 
     # Clean up technique names
     df_long['Technique'] = df_long['Technique_Raw'].map(lambda x: TECHNIQUE_MAP[x])
@@ -92,7 +236,7 @@ scale_filter = 'Macro' if 'Macro' in selected_scale else 'Micro'
 # Filter 1: Select Metric Type
 selected_metric_type = st.sidebar.radio(
     "2. Select Analysis Metric",
-    ('Total Probes', 'Insertion Time (ms)'),
+    tuple(METRIC_GROUPS.keys()),
     horizontal=True
 )
 
@@ -199,6 +343,136 @@ with col2:
 
     st.plotly_chart(fig, use_container_width=True)
 
+# --- Concurrent Benchmark Section (optional) ---
+# Written by `./analyzer --concurrent > concurrent_data.csv`; shown only
+# when the file is present.
+if os.path.exists(CONCURRENT_PATH):
+    st.subheader("Concurrent Insert Throughput (shared table)")
+    df_conc = pd.read_csv(CONCURRENT_PATH)
+    fig_conc = px.line(
+        df_conc,
+        x='Threads',
+        y='Inserts_Per_Sec',
+        color='Flavor',
+        markers=True,
+        title="Aggregate inserts/sec vs. inserter threads",
+        labels={'Inserts_Per_Sec': 'Inserts per second'},
+        height=400
+    )
+    st.plotly_chart(fig_conc, use_container_width=True)
+
+# --- Live Simulation Section (optional) ---
+# Attaches to the shared-memory ring of a running sweep so partial
+# results render without waiting for results_data.csv. Records wrap
+# once the ring is full; the newest window always survives.
+if os.path.exists(SHM_LIVE_PATH):
+    st.subheader("Live Simulation (attached to running sweep)")
+    if st.button("Refresh live view"):
+        st.rerun()
+    with open(SHM_LIVE_PATH, 'rb') as f:
+        shm_buf = f.read()
+    magic, shm_version, shm_record_size, shm_capacity = struct.unpack('<4sIII', shm_buf[:16])
+    shm_head = struct.unpack('<Q', shm_buf[16:24])[0]
+    if magic != SHM_MAGIC:
+        st.warning(f"{SHM_LIVE_PATH} is not an analyzer live ring.")
+    elif shm_head == 0:
+        st.info("Ring attached; no sample windows published yet.")
+    else:
+        shm_dtype = np.dtype(
+            [('Scale', 'S16'), ('Distribution', 'S16'), ('Technique', 'S32'),
+             ('Key_Index', '<i8'), ('Load_Factor', '<f8'),
+             ('Probes', '<i8'), ('Time_ms', '<f8'), ('ns_per_op', '<f8'),
+             ('Probe_Max', '<i8'), ('Probe_Var', '<f8'),
+             ('Miss_Probes_Avg', '<f8'), ('Mem_Bytes', '<i8'),
+             ('Bytes_Per_Key', '<f8')]
+        )
+        count = min(shm_head, shm_capacity)
+        live = np.frombuffer(shm_buf, dtype=shm_dtype, count=count, offset=24)
+        df_live = pd.DataFrame(live)
+        for col in ('Scale', 'Distribution', 'Technique'):
+            df_live[col] = df_live[col].str.decode('utf-8')
+        df_live['Technique'] = df_live['Technique'].map(TECHNIQUES).fillna(df_live['Technique'])
+        progress = (df_live.groupby(['Scale', 'Distribution', 'Technique'])['Load_Factor']
+                    .max().reset_index().rename(columns={'Load_Factor': 'Reached α'}))
+        st.dataframe(progress, use_container_width=True)
+        fig_live = px.line(
+            df_live.sort_values('Key_Index'),
+            x='Load_Factor',
+            y='Probes',
+            color='Technique',
+            line_dash='Distribution',
+            title=f"Live cumulative probes ({shm_head} windows published)",
+            height=500
+        )
+        st.plotly_chart(fig_live, use_container_width=True)
+
+# --- Probe-Length Distribution Section (optional) ---
+# Written by `./analyzer --hist-out probe_hist.csv`; per-window
+# histograms turn the averaged probe columns into percentile bands and
+# CCDF tails, which is what the probe-length SLOs are actually about.
+if os.path.exists(HIST_PATH):
+    st.subheader("Probe-Length Distribution (per sample window)")
+    df_hist = pd.read_csv(HIST_PATH)
+    df_hist['Technique'] = df_hist['Technique'].map(TECHNIQUES).fillna(df_hist['Technique'])
+    df_hist = df_hist[
+        (df_hist['Scale'] == scale_filter) &
+        (df_hist['Distribution'].isin(selected_distributions)) &
+        (df_hist['Technique'].isin(selected_techniques)) &
+        (df_hist['Load_Factor'] <= max_load_factor)
+    ]
+    if df_hist.empty:
+        st.info("No histogram rows match the current filters.")
+    else:
+        def hist_percentile(group, q):
+            group = group.sort_values('Probe_Len')
+            cum = group['Count'].cumsum()
+            total = group['Count'].sum()
+            return group['Probe_Len'][cum >= q * total].iloc[0]
+
+        bands = []
+        for (dist, tech, lf), g in df_hist.groupby(['Distribution', 'Technique', 'Load_Factor']):
+            for q, label in ((0.50, 'p50'), (0.90, 'p90'), (0.99, 'p99')):
+                bands.append({'Distribution': dist, 'Technique': tech,
+                              'Load_Factor': lf, 'Percentile': label,
+                              'Probe_Len': hist_percentile(g, q)})
+        df_bands = pd.DataFrame(bands)
+        fig_bands = px.line(
+            df_bands,
+            x='Load_Factor',
+            y='Probe_Len',
+            color='Technique',
+            line_dash='Percentile',
+            title="Probe-length percentiles vs. load factor (per window)",
+            labels={'Probe_Len': 'Probe length'},
+            height=500
+        )
+        st.plotly_chart(fig_bands, use_container_width=True)
+
+        # CCDF of the window closest to the selected max load factor.
+        last_lf = df_hist['Load_Factor'].max()
+        df_tail = df_hist[df_hist['Load_Factor'] == last_lf].copy()
+        ccdf_rows = []
+        for (dist, tech), g in df_tail.groupby(['Distribution', 'Technique']):
+            g = g.sort_values('Probe_Len')
+            total = g['Count'].sum()
+            survivors = total - g['Count'].cumsum().shift(fill_value=0)
+            for plen, surv in zip(g['Probe_Len'], survivors):
+                ccdf_rows.append({'Distribution': dist, 'Technique': tech,
+                                  'Probe_Len': plen, 'Fraction': surv / total})
+        df_ccdf = pd.DataFrame(ccdf_rows)
+        fig_ccdf = px.line(
+            df_ccdf,
+            x='Probe_Len',
+            y='Fraction',
+            color='Technique',
+            line_dash='Distribution',
+            log_y=True,
+            title=f"CCDF P(probe ≥ x) at α ≈ {last_lf:.2f}",
+            labels={'Fraction': 'P(probe ≥ x)', 'Probe_Len': 'Probe length'},
+            height=500
+        )
+        st.plotly_chart(fig_ccdf, use_container_width=True)
+
 # --- Raw Data Section ---
 if st.checkbox("Show Raw Data Table", value=False):
     st.subheader(f"Raw Simulation Data ({scale_filter} Scale)")
@@ -1,8 +1,15 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
 #include <time.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
 
 #define TABLE_SIZE 10000
 #define NUM_INSERTIONS TABLE_SIZE
@@ -10,98 +17,737 @@
 #define MICRO_TABLE_SIZE 13 // Small prime size for micro-analysis
 
 #define LOAD_FACTOR_STEPS 100
-#define STEP_SIZE (NUM_INSERTIONS / LOAD_FACTOR_STEPS)
+
+#define EMPTY_SLOT ((uint64_t)-1)
+// Tombstone left by open-addressing deletes: lookups probe past it,
+// inserts may reclaim it.
+#define DELETED_SLOT ((uint64_t)-2)
+
+// Metadata bytes for the Swiss-style layout; the top bit distinguishes
+// control bytes (empty/tombstone) from 7-bit hash fragments.
+#define META_EMPTY 0x80
+#define META_DELETED 0xFE
 
 // --- Data Structures ---
 
 // 1. Separate Chaining Node
 typedef struct Node {
-    int key;
+    uint64_t key;
     struct Node *next;
 } Node;
 
-// Hash Table arrays (dynamically sized based on run context)
-Node** chaining_table_ptr;
-int* probing_table_ptr;
-int current_table_size;
+// --- Arena Allocator for Chain Nodes ---
+
+// Chain nodes are carved out of large slabs with a bump pointer instead
+// of one malloc per key: a 10M-key run otherwise makes 10M tiny
+// allocations, and freeing them one-by-one in cleanup dominates
+// teardown time. Slabs also keep each run's chains contiguous in
+// memory, which is how a real chained table would be laid out.
+#define ARENA_SLAB_NODES 4096
+
+typedef struct ArenaSlab {
+    struct ArenaSlab *next;
+    int used;
+    Node nodes[ARENA_SLAB_NODES];
+} ArenaSlab;
+
+typedef struct {
+    ArenaSlab *head;    // slabs in allocation order
+    ArenaSlab *current; // slab being bump-allocated from
+} Arena;
+
+static Node *arena_alloc_node(Arena *arena) {
+    ArenaSlab *slab = arena->current;
+    if (slab == NULL || slab->used == ARENA_SLAB_NODES) {
+        if (slab != NULL && slab->next != NULL) {
+            // Reuse a slab retained from a previous run.
+            slab = slab->next;
+        } else {
+            ArenaSlab *fresh = (ArenaSlab*)malloc(sizeof(ArenaSlab));
+            if (fresh == NULL) { return NULL; }
+            fresh->next = NULL;
+            if (slab != NULL) {
+                slab->next = fresh;
+            } else {
+                arena->head = fresh;
+            }
+            slab = fresh;
+        }
+        slab->used = 0;
+        arena->current = slab;
+    }
+    return &slab->nodes[slab->used++];
+}
+
+// Rewinds the arena for reuse without freeing slabs, so sweep runs
+// don't pay allocator warm-up per table size.
+static void arena_reset(Arena *arena) {
+    arena->current = arena->head;
+    if (arena->head != NULL) { arena->head->used = 0; }
+}
+
+// Frees the whole arena in O(slabs) instead of O(nodes).
+static void arena_release(Arena *arena) {
+    ArenaSlab *slab = arena->head;
+    while (slab != NULL) {
+        ArenaSlab *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
+}
+
+// Cell-packed chaining bucket: CELL_CAP keys live inline (one cache
+// line, no pointer chase) and only spill to chain nodes beyond that.
+#define CELL_CAP 6
+
+typedef struct {
+    Node *overflow;
+    int count;
+    uint64_t keys[CELL_CAP];
+} CellBucket;
+
+// Per-run table state. Each (scenario, technique) pairing owns one of
+// these, so runs can execute on separate worker threads without sharing
+// any mutable state. Replaces the old chaining_table_ptr /
+// probing_table_ptr / current_table_size globals.
+typedef struct {
+    size_t table_size;
+    size_t capacity; // allocated slots; reused across runs when large enough
+    Node **chaining_table;
+    uint64_t *probing_table;
+    // Parallel control-byte array for the Swiss-style layout: probes
+    // scan these 1-byte tags, so one cache line covers 64 slots, and
+    // the 4-byte key array is only touched to store the winning slot.
+    unsigned char *meta_table;
+    CellBucket *cell_table;
+    Arena node_arena;
+    long cell_overflow_nodes; // spilled keys, for footprint accounting
+
+    // Growth-policy state (--grow-at). While migrating, the previous
+    // generation's arrays stay live so lookups can fall back to them,
+    // and inserts move a bounded number of old buckets each.
+    long live_keys;     // inserted minus deleted
+    int migrating;      // old arrays still hold entries
+    size_t old_size;
+    size_t old_capacity;   // allocation size of the old arrays
+    size_t migrate_cursor; // next old bucket to move
+    Node **old_chaining;
+    uint64_t *old_probing;
+    unsigned char *old_meta;
+    CellBucket *old_cell;
+    long migration_probes;
+    uint64_t migration_ns;
+
+    // Cuckoo state: keys whose kick chain exceeds the bound land in a
+    // small stash; once that overflows, the insert is counted as a
+    // rehash-triggering failure.
+    uint64_t cuckoo_stash[8];
+    int stash_used;
+    long cuckoo_failures;
+    long stash_hits;
+
+    // Pending keys for the batched variant; flushed through the
+    // software-pipelined resolver once --batch-size keys accumulate.
+    uint64_t batch_buf[64];
+    int batch_fill;
+} TableCtx;
+
+#define BATCH_MAX (int)(sizeof(((TableCtx*)0)->batch_buf) / sizeof(uint64_t))
+
+#define CUCKOO_STASH (int)(sizeof(((TableCtx*)0)->cuckoo_stash) / sizeof(uint64_t))
+#define CUCKOO_MAX_KICKS 32
 
-#define EMPTY_SLOT -1
+// --- Collision Techniques ---
+
+typedef enum {
+    TECH_CHAINING = 0,
+    TECH_LINEAR,
+    TECH_QUADRATIC,
+    TECH_DOUBLE,
+    TECH_META,
+    TECH_SIMD,
+    TECH_ROBIN_HOOD,
+    TECH_CUCKOO,
+    TECH_PREFETCH_CHAIN,
+    TECH_CELL_CHAIN,
+    TECH_BATCH,
+    TECH_TRIANGULAR,
+    NUM_TECHNIQUES
+} Technique;
+
+static const char *technique_names[NUM_TECHNIQUES] = {
+    "Chaining",
+    "Linear_Probing",
+    "Quadratic_Probing",
+    "Double_Hashing",
+    "Meta_Probing",
+    "SIMD_Probing",
+    "Robin_Hood",
+    "Cuckoo",
+    "Prefetch_Chaining",
+    "Cell_Chaining",
+    "Batched_Probing",
+    "Triangular_Probing"
+};
 
 // --- Utility Functions ---
 
-// Basic Hash Function
-int hash1(int key) {
-    return key % current_table_size;
+// --- Hash Function Suite ---
+
+// Selectable via --hash. Modulo is the historical default; the mixers
+// spread clustered key streams before range reduction, which absorbs
+// patterns the Worst_Case generator exploits against plain modulo.
+typedef enum {
+    HASH_MODULO = 0,   // key % size (legacy)
+    HASH_MULT,         // Fibonacci multiplicative
+    HASH_MURMUR,       // Murmur3-style finalizer
+    HASH_XX,           // xxHash32-style avalanche
+    NUM_HASH_KINDS
+} HashKind;
+
+static const char *hash_kind_names[NUM_HASH_KINDS] = {
+    "Modulo", "Multiplicative", "Murmur", "XXMix"
+};
+
+static int hash_kind = HASH_MODULO;
+
+static uint64_t hash_mix(uint64_t k) {
+    switch (hash_kind) {
+    case HASH_MULT:
+        return k * 11400714819323198485ull; // 2^64 / golden ratio
+    case HASH_MURMUR:
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdull;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ull;
+        k ^= k >> 33;
+        return k;
+    case HASH_XX:
+        k ^= k >> 33;
+        k *= 0xc2b2ae3d27d4eb4full;
+        k ^= k >> 29;
+        k *= 0x165667b19e3779f9ull;
+        k ^= k >> 32;
+        return k;
+    default:
+        return k;
+    }
+}
+
+// Fast-range reduction: power-of-two tables use a mask instead of the
+// integer divide that otherwise sits in every probe (20+ cycles, once
+// per probe iteration — the hottest instruction at high load factors).
+static size_t reduce_index(const TableCtx *ctx, uint64_t h) {
+    size_t size = ctx->table_size;
+    if ((size & (size - 1)) == 0) {
+        return (size_t)(h & (uint64_t)(size - 1));
+    }
+    return (size_t)(h % (uint64_t)size);
+}
+
+// Basic Hash Function. Keys are unsigned 64-bit, so the legacy modulo
+// path no longer has to fold negative remainders, and both paths share
+// the mask fast-path in reduce_index for power-of-two sizes.
+size_t hash1(const TableCtx *ctx, uint64_t key) {
+    if (hash_kind == HASH_MODULO) {
+        return reduce_index(ctx, key);
+    }
+    uint64_t h = hash_mix(key);
+    size_t size = ctx->table_size;
+    if (hash_kind == HASH_MULT && size > 1 && (size & (size - 1)) == 0) {
+        // Fibonacci hashing lives in the TOP bits: masking the low
+        // bits of k*C is just a permutation of the key's own low bits
+        // and absorbs nothing, so take the top log2(size) bits.
+        return (size_t)(h >> (64 - __builtin_ctzll((uint64_t)size)));
+    }
+    return reduce_index(ctx, h);
+}
+
+// Second Hash Function for Double Hashing. The legacy step of 1..7
+// clusters badly on large tables, so the mixer kinds derive a
+// full-range step instead (odd, so power-of-two tables stay covered).
+size_t hash2(const TableCtx *ctx, uint64_t key) {
+    if (hash_kind == HASH_MODULO) {
+        return 7 - (size_t)(key % 7);
+    }
+    uint64_t s = hash_mix(key * 0x9e3779b97f4a7c15ull + 1u);
+    size_t size = ctx->table_size;
+    size_t step = 1 + (size_t)(s % (uint64_t)(size - 1));
+    if ((size & (size - 1)) == 0) {
+        return step | 1; // odd strides cover power-of-two tables
+    }
+    // Forcing odd on other sizes can round step size-1 up to size —
+    // stride 0 mod size, a probe loop that never advances. Any step in
+    // [1, size-1] is already coprime to a prime size.
+    return step;
+}
+
+// --- Seeded PRNG (--seed) ---
+
+// rand() was seeded from the wall clock and serialised behind a lock,
+// so no two runs produced comparable key streams and results_data.csv
+// could never be regenerated bit-for-bit. splitmix64 expands the seed
+// into per-scenario xoshiro256++ states, so every scenario owns an
+// independent stream and generation is safe off the main thread.
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static uint64_t rng_seed = 1; // --seed
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static void rng_init(Rng *rng, uint64_t seed, uint64_t stream) {
+    uint64_t state = seed ^ (stream * 0x9e3779b97f4a7c15ull);
+    for (int i = 0; i < 4; i++) { rng->s[i] = splitmix64(&state); }
+}
+
+static uint64_t rotl64(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
 }
 
-// Second Hash Function for Double Hashing
-int hash2(int key) {
-    return 7 - (key % 7);
+static uint64_t rng_next(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl64(s[0] + s[3], 23) + s[0];
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+    return result;
 }
 
-// Key Generation Functions (remain the same)
-int generate_worst_case_key(int index) {
+// --- Key Generation Functions ---
+
+// Set by scenario_prepare before each key stream is drawn, so the
+// parameterized generators below know the scenario's geometry without
+// widening the generator callback signature.
+static size_t key_gen_table_size = TABLE_SIZE;
+static long key_gen_universe = NUM_INSERTIONS;
+
+static double zipf_s = 0.99;    // --zipf-s
+static long cluster_burst = 16; // --burst-len
+
+uint64_t generate_worst_case_key(Rng *rng, long index) {
     // Generate keys that all map to the same small set of initial slots
-    return (index * 100) + (index % 5);
+    (void)rng;
+    return (uint64_t)index * 100 + (uint64_t)(index % 5);
 }
 
-int generate_skewed_key(int index) {
+uint64_t generate_skewed_key(Rng *rng, long index) {
     // Generate keys that tend to cluster slightly
-    return (index * 7) + (rand() % 100);
+    return (uint64_t)index * 7 + rng_next(rng) % 100;
 }
 
-int generate_uniform_key(int index) {
-    // Pure random key
-    return rand() * index;
+uint64_t generate_uniform_key(Rng *rng, long index) {
+    // Full-range random key over the whole 64-bit identifier space.
+    (void)index;
+    return rng_next(rng);
 }
 
-void initialize_tables(int size) {
-    current_table_size = size;
-    chaining_table_ptr = (Node**)malloc(sizeof(Node*) * size);
-    probing_table_ptr = (int*)malloc(sizeof(int) * size);
-    
-    if (chaining_table_ptr == NULL || probing_table_ptr == NULL) {
+// Zipf(s) over key_gen_universe ranks via the standard precomputed-CDF
+// sampler: the O(N) harmonic table is built once per (N, s) pair and
+// amortized across every draw; each draw is then one uniform variate
+// and a binary search. Ranks are scrambled through splitmix64 so hot
+// keys are spread over the identifier space instead of being small
+// integers the mixer kinds would place suspiciously well.
+static double *zipf_cdf = NULL;
+static long zipf_cdf_n = 0;
+static double zipf_cdf_s = -1.0;
+
+static void zipf_build_cdf(long n, double s) {
+    free(zipf_cdf);
+    zipf_cdf = (double*)malloc(sizeof(double) * n);
+    if (zipf_cdf == NULL) {
         fprintf(stderr, "Memory allocation failed.\n");
         exit(1);
     }
+    double sum = 0.0;
+    for (long r = 0; r < n; r++) {
+        sum += 1.0 / pow((double)(r + 1), s);
+        zipf_cdf[r] = sum;
+    }
+    for (long r = 0; r < n; r++) { zipf_cdf[r] /= sum; }
+    zipf_cdf_n = n;
+    zipf_cdf_s = s;
+}
 
-    for (int i = 0; i < size; i++) {
-        chaining_table_ptr[i] = NULL;
-        probing_table_ptr[i] = EMPTY_SLOT;
+uint64_t generate_zipf_key(Rng *rng, long index) {
+    (void)index;
+    if (zipf_cdf_n != key_gen_universe || zipf_cdf_s != zipf_s) {
+        zipf_build_cdf(key_gen_universe, zipf_s);
+    }
+    double u = (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+    long lo = 0;
+    long hi = zipf_cdf_n - 1;
+    while (lo < hi) {
+        long mid = lo + (hi - lo) / 2;
+        if (zipf_cdf[mid] < u) { lo = mid + 1; } else { hi = mid; }
     }
+    uint64_t state = (uint64_t)lo + 1;
+    return splitmix64(&state);
 }
 
-void cleanup_tables(int size) {
-    for (int i = 0; i < size; i++) {
-        Node *current = chaining_table_ptr[i];
-        while (current != NULL) {
-            Node *temp = current;
-            current = current->next;
-            free(temp);
+// Runs of cluster_burst consecutive keys from random bases, modeling
+// bulk loads of adjacent identifiers (time-ordered IDs, scan inserts).
+static uint64_t cluster_base = 0;
+
+uint64_t generate_clustered_key(Rng *rng, long index) {
+    long offset = index % cluster_burst;
+    if (offset == 0) { cluster_base = rng_next(rng); }
+    return cluster_base + (uint64_t)offset;
+}
+
+// Inverts the selected hash1 so every key lands in bucket zero of a
+// key_gen_table_size-slot table: the pre-reduction value index*size is
+// pushed backwards through the mixer (xor-shifts of width >= 32 are
+// involutions, shorter ones unwind iteratively, multiplies by the
+// odd-constant modular inverse). Keys stay distinct, probes explode.
+static uint64_t mult_inverse64(uint64_t a) {
+    uint64_t x = a; // Newton's iteration doubles correct bits each step
+    for (int i = 0; i < 5; i++) { x *= 2 - a * x; }
+    return x;
+}
+
+static uint64_t unshift_right(uint64_t x, int s) {
+    uint64_t r = x;
+    for (int done = s; done < 64; done += s) { r = x ^ (r >> s); }
+    return r;
+}
+
+uint64_t generate_adversarial_key(Rng *rng, long index) {
+    (void)rng;
+    uint64_t h = (uint64_t)index * (uint64_t)key_gen_table_size;
+    switch (hash_kind) {
+    case HASH_MULT:
+        if (key_gen_table_size > 1 &&
+            (key_gen_table_size & (key_gen_table_size - 1)) == 0) {
+            // Power-of-two tables bucket by the TOP bits of k*C, so
+            // any product below 2^(64 - log2(size)) lands in bucket
+            // zero; plain index stays far below that bound.
+            h = (uint64_t)index;
+        }
+        return h * mult_inverse64(11400714819323198485ull);
+    case HASH_MURMUR:
+        h = unshift_right(h, 33);
+        h *= mult_inverse64(0xc4ceb9fe1a85ec53ull);
+        h = unshift_right(h, 33);
+        h *= mult_inverse64(0xff51afd7ed558ccdull);
+        h = unshift_right(h, 33);
+        return h;
+    case HASH_XX:
+        h = unshift_right(h, 32);
+        h *= mult_inverse64(0x165667b19e3779f9ull);
+        h = unshift_right(h, 29);
+        h *= mult_inverse64(0xc2b2ae3d27d4eb4full);
+        h = unshift_right(h, 33);
+        return h;
+    default:
+        return h; // modulo: any multiple of size reduces to zero
+    }
+}
+
+// --- Key Distributions ---
+
+typedef struct {
+    const char *name;
+    uint64_t (*generator)(Rng*, long);
+} Distribution;
+
+static const Distribution distributions[] = {
+    { "Uniform",     generate_uniform_key },
+    { "Skewed",      generate_skewed_key },
+    { "Worst_Case",  generate_worst_case_key },
+    { "Zipf",        generate_zipf_key },
+    { "Clustered",   generate_clustered_key },
+    { "Adversarial", generate_adversarial_key },
+};
+#define NUM_DISTRIBUTIONS (int)(sizeof(distributions) / sizeof(distributions[0]))
+
+// --- Table Allocation (--pages / --numa) ---
+
+// Plain malloc backs large probing arrays with 4 KB pages, so at
+// random-access table sizes every probe risks a TLB miss on top of the
+// cache miss, and first-touch lands the whole table on one NUMA node.
+// --pages thp maps the arrays anonymously and advises transparent huge
+// pages; --pages hugetlb demands explicit 2 MB pages (falling back to
+// thp with a warning when the pool is empty); --numa interleaves the
+// mapping across all nodes via mbind. The effective configuration is
+// recorded in the Page_Mode output column so TLB effects can be
+// charted across table sizes.
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+typedef enum {
+    PAGES_MALLOC = 0,
+    PAGES_THP,
+    PAGES_HUGETLB,
+    NUM_PAGE_MODES
+} PageMode;
+
+static const char *page_mode_names[NUM_PAGE_MODES] = {
+    "malloc", "thp", "hugetlb"
+};
+
+static int page_mode = PAGES_MALLOC;       // --pages
+static int page_mode_effective = PAGES_MALLOC; // after hugetlb fallback
+static int numa_interleave = 0;            // --numa interleave
+
+// The string that lands in the Page_Mode column.
+static const char *page_config_name(void) {
+    static char name[16]; // longest value is "hugetlb+numa"; sized to
+                          // fit BinRecord.page_mode without truncation
+    snprintf(name, sizeof(name), "%s%s", page_mode_names[page_mode_effective],
+             numa_interleave ? "+numa" : "");
+    return name;
+}
+
+static void table_numa_spread(void *p, size_t bytes) {
+#ifdef __linux__
+    // MPOL_INTERLEAVE over all nodes, via the raw syscall so libnuma
+    // isn't a build dependency (same pattern as perf_event_open).
+    unsigned long nodemask = ~0ul;
+    if (syscall(SYS_mbind, p, bytes, 3 /* MPOL_INTERLEAVE */,
+                &nodemask, sizeof(nodemask) * 8 + 1, 0) != 0) {
+        static int warned = 0;
+        if (!warned) {
+            fprintf(stderr, "mbind failed; continuing without NUMA interleave.\n");
+            warned = 1;
         }
     }
-    free(chaining_table_ptr);
-    free(probing_table_ptr);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+static void *table_alloc(size_t bytes) {
+    if (page_mode == PAGES_MALLOC) {
+        void *p = malloc(bytes);
+        if (p != NULL && numa_interleave) { table_numa_spread(p, bytes); }
+        return p;
+    }
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+    if (page_mode == PAGES_HUGETLB) { flags |= MAP_HUGETLB; }
+#endif
+    void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (p == MAP_FAILED && page_mode == PAGES_HUGETLB) {
+        static int warned = 0;
+        if (!warned) {
+            fprintf(stderr, "MAP_HUGETLB failed (empty hugepage pool?); "
+                            "falling back to transparent huge pages.\n");
+            warned = 1;
+        }
+        page_mode_effective = PAGES_THP;
+        p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (p == MAP_FAILED) { return NULL; }
+#ifdef MADV_HUGEPAGE
+    if (page_mode_effective != PAGES_HUGETLB) { madvise(p, bytes, MADV_HUGEPAGE); }
+#endif
+    if (numa_interleave) { table_numa_spread(p, bytes); }
+    return p;
+}
+
+static void table_free(void *p, size_t bytes) {
+    if (p == NULL) { return; }
+    if (page_mode == PAGES_MALLOC) {
+        free(p);
+    } else {
+        munmap(p, bytes);
+    }
+}
+
+// Which storage layouts a technique touches. Contexts allocate only
+// these: the four layouts together cost ~81 B/slot (the CellBucket
+// array alone is 64 B/slot), which at the multi-GB table sizes the
+// page modes target would multiply an 8 GB probing run into ~80 GB.
+#define LAYOUT_CHAIN   1u
+#define LAYOUT_PROBING 2u
+#define LAYOUT_META    4u
+#define LAYOUT_CELL    8u
+
+static unsigned int technique_layouts(Technique tech) {
+    switch (tech) {
+    case TECH_CHAINING:
+    case TECH_PREFETCH_CHAIN: return LAYOUT_CHAIN;
+    case TECH_META:           return LAYOUT_PROBING | LAYOUT_META;
+    case TECH_CELL_CHAIN:     return LAYOUT_CELL;
+    default:                  return LAYOUT_PROBING;
+    }
+}
+
+// Allocates any layout arrays from the set that the context is still
+// missing, at the current capacity. Arrays a technique never touches
+// stay NULL; table_ctx_reset and the grow path skip them.
+static void table_ctx_ensure_layouts(TableCtx *ctx, unsigned int layouts) {
+    size_t cap = ctx->capacity;
+    if ((layouts & LAYOUT_CHAIN) && ctx->chaining_table == NULL) {
+        ctx->chaining_table = (Node**)table_alloc(sizeof(Node*) * cap);
+    }
+    if ((layouts & LAYOUT_PROBING) && ctx->probing_table == NULL) {
+        ctx->probing_table = (uint64_t*)table_alloc(sizeof(uint64_t) * cap);
+    }
+    if ((layouts & LAYOUT_META) && ctx->meta_table == NULL) {
+        ctx->meta_table = (unsigned char*)table_alloc(sizeof(unsigned char) * cap);
+    }
+    if ((layouts & LAYOUT_CELL) && ctx->cell_table == NULL) {
+        ctx->cell_table = (CellBucket*)table_alloc(sizeof(CellBucket) * cap);
+    }
+    if (((layouts & LAYOUT_CHAIN) && ctx->chaining_table == NULL) ||
+        ((layouts & LAYOUT_PROBING) && ctx->probing_table == NULL) ||
+        ((layouts & LAYOUT_META) && ctx->meta_table == NULL) ||
+        ((layouts & LAYOUT_CELL) && ctx->cell_table == NULL)) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(1);
+    }
+}
+
+void table_ctx_init(TableCtx *ctx, size_t size, unsigned int layouts) {
+    ctx->table_size = size;
+    ctx->capacity = size;
+    ctx->chaining_table = NULL;
+    ctx->probing_table = NULL;
+    ctx->meta_table = NULL;
+    ctx->cell_table = NULL;
+    table_ctx_ensure_layouts(ctx, layouts);
+
+    if (ctx->chaining_table != NULL) {
+        for (size_t i = 0; i < size; i++) { ctx->chaining_table[i] = NULL; }
+    }
+    if (ctx->probing_table != NULL) {
+        for (size_t i = 0; i < size; i++) { ctx->probing_table[i] = EMPTY_SLOT; }
+    }
+    if (ctx->meta_table != NULL) { memset(ctx->meta_table, META_EMPTY, size); }
+    if (ctx->cell_table != NULL) {
+        memset(ctx->cell_table, 0, sizeof(CellBucket) * size);
+    }
+    ctx->node_arena.head = NULL;
+    ctx->node_arena.current = NULL;
+    ctx->cell_overflow_nodes = 0;
+
+    ctx->live_keys = 0;
+    ctx->migrating = 0;
+    ctx->old_size = 0;
+    ctx->old_capacity = 0;
+    ctx->migrate_cursor = 0;
+    ctx->old_chaining = NULL;
+    ctx->old_probing = NULL;
+    ctx->old_meta = NULL;
+    ctx->old_cell = NULL;
+    ctx->migration_probes = 0;
+    ctx->migration_ns = 0;
+    ctx->stash_used = 0;
+    ctx->cuckoo_failures = 0;
+    ctx->stash_hits = 0;
+    ctx->batch_fill = 0;
+}
+
+// Frees the previous generation's arrays once migration finishes (or
+// when the context is reset/torn down mid-migration).
+static void table_ctx_drop_old(TableCtx *ctx) {
+    table_free(ctx->old_chaining, sizeof(Node*) * ctx->old_capacity);
+    table_free(ctx->old_probing, sizeof(uint64_t) * ctx->old_capacity);
+    table_free(ctx->old_meta, sizeof(unsigned char) * ctx->old_capacity);
+    table_free(ctx->old_cell, sizeof(CellBucket) * ctx->old_capacity);
+    ctx->old_chaining = NULL;
+    ctx->old_probing = NULL;
+    ctx->old_meta = NULL;
+    ctx->old_cell = NULL;
+    ctx->old_size = 0;
+    ctx->old_capacity = 0;
+    ctx->migrating = 0;
+    ctx->migrate_cursor = 0;
+}
+
+// Clears an already-allocated context for the next run. Used by the
+// sweep/sequential paths so successive runs reuse table memory instead
+// of paying a malloc/free cycle per (size, distribution) cell.
+void table_ctx_reset(TableCtx *ctx, size_t size) {
+    ctx->table_size = size;
+    if (ctx->chaining_table != NULL) {
+        for (size_t i = 0; i < size; i++) { ctx->chaining_table[i] = NULL; }
+    }
+    if (ctx->probing_table != NULL) {
+        for (size_t i = 0; i < size; i++) { ctx->probing_table[i] = EMPTY_SLOT; }
+    }
+    if (ctx->meta_table != NULL) { memset(ctx->meta_table, META_EMPTY, size); }
+    if (ctx->cell_table != NULL) {
+        memset(ctx->cell_table, 0, sizeof(CellBucket) * size);
+    }
+    arena_reset(&ctx->node_arena);
+    ctx->cell_overflow_nodes = 0;
+    table_ctx_drop_old(ctx);
+    ctx->live_keys = 0;
+    ctx->migration_probes = 0;
+    ctx->migration_ns = 0;
+    ctx->stash_used = 0;
+    ctx->cuckoo_failures = 0;
+    ctx->stash_hits = 0;
+    ctx->batch_fill = 0;
+}
+
+void table_ctx_cleanup(TableCtx *ctx) {
+    // Chain nodes all live in the arena, so no per-node free is needed.
+    table_ctx_drop_old(ctx);
+    arena_release(&ctx->node_arena);
+    table_free(ctx->chaining_table, sizeof(Node*) * ctx->capacity);
+    table_free(ctx->probing_table, sizeof(uint64_t) * ctx->capacity);
+    table_free(ctx->meta_table, sizeof(unsigned char) * ctx->capacity);
+    table_free(ctx->cell_table, sizeof(CellBucket) * ctx->capacity);
+    ctx->chaining_table = NULL;
+    ctx->probing_table = NULL;
+    ctx->meta_table = NULL;
+    ctx->cell_table = NULL;
+    ctx->capacity = 0;
+}
+
+// Makes ctx ready for a run at the given size with the layouts the
+// technique needs, reusing existing allocations when they are large
+// enough and adding missing layouts on demand.
+void table_ctx_prepare(TableCtx *ctx, size_t size, unsigned int layouts) {
+    if (ctx->capacity >= size) {
+        table_ctx_ensure_layouts(ctx, layouts);
+        table_ctx_reset(ctx, size);
+    } else {
+        if (ctx->capacity > 0) { table_ctx_cleanup(ctx); }
+        table_ctx_init(ctx, size, layouts);
+    }
 }
 
 
 // --- Collision Resolution Techniques (Return Probes) ---
 
 // 1. Separate Chaining
-long insert_chaining(int key) {
-    int index = hash1(key);
+long insert_chaining(TableCtx *ctx, uint64_t key) {
+    size_t index = hash1(ctx, key);
     long probes = 1;
 
-    Node *newNode = (Node*)malloc(sizeof(Node));
+    Node *newNode = arena_alloc_node(&ctx->node_arena);
     if (newNode == NULL) { return 0; }
 
     newNode->key = key;
     newNode->next = NULL;
 
-    if (chaining_table_ptr[index] == NULL) {
-        chaining_table_ptr[index] = newNode;
+    if (ctx->chaining_table[index] == NULL) {
+        ctx->chaining_table[index] = newNode;
     } else {
-        Node *current = chaining_table_ptr[index];
+        Node *current = ctx->chaining_table[index];
         while (current->next != NULL) {
             current = current->next;
             probes++;
@@ -112,158 +758,3199 @@ long insert_chaining(int key) {
 }
 
 // 2. Linear Probing
-long insert_linear_probing(int key) {
-    int initial_index = hash1(key);
+long insert_linear_probing(TableCtx *ctx, uint64_t key) {
+    size_t initial_index = hash1(ctx, key);
     long probes = 0;
 
-    for (int i = 0; i < current_table_size; i++) {
+    for (size_t i = 0; i < ctx->table_size; i++) {
         probes++;
-        int index = (initial_index + i) % current_table_size;
+        size_t index = (initial_index + i) % ctx->table_size;
 
-        if (probing_table_ptr[index] == EMPTY_SLOT) {
-            probing_table_ptr[index] = key;
+        uint64_t slot = ctx->probing_table[index];
+        if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+            ctx->probing_table[index] = key;
             return probes;
         }
     }
     return probes;
 }
 
-// 3. Quadratic Probing
-long insert_quadratic_probing(int key) {
-    int initial_index = hash1(key);
+// 3. Quadratic Probing (legacy baseline). The i*i offsets revisit
+// slots for arbitrary table sizes, so at high load factors this can
+// fail to find empty slots that exist; kept for comparison against the
+// covering triangular variant below.
+long insert_quadratic_probing(TableCtx *ctx, uint64_t key) {
+    size_t initial_index = hash1(ctx, key);
     long probes = 0;
 
-    for (int i = 0; i < current_table_size; i++) {
+    for (size_t i = 0; i < ctx->table_size; i++) {
         probes++;
-        int index = (initial_index + i * i) % current_table_size;
+        size_t index = (initial_index + i * i) % ctx->table_size;
+
+        uint64_t slot = ctx->probing_table[index];
+        if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+            ctx->probing_table[index] = key;
+            return probes;
+        }
+    }
+    return probes;
+}
+
+// 3b. Triangular-number quadratic probing, the canonical quadratic
+// implementation: offsets 0,1,3,6,... visit every slot of a
+// power-of-two table exactly once in table_size probes, so the probe
+// loop terminating without a hit means the table really is full — no
+// cycle can hide an empty slot. The index advances incrementally
+// (index += ++step, mask) instead of recomputing i*i with a multiply
+// and a 20+-cycle divide every iteration; non-power-of-two sizes keep
+// the incremental walk with a wrap-by-subtract and inherit the legacy
+// variant's bounded-scan behavior, since coverage is only guaranteed
+// with the mask.
+long insert_triangular_probing(TableCtx *ctx, uint64_t key) {
+    size_t size = ctx->table_size;
+    size_t index = hash1(ctx, key);
+    long probes = 0;
 
-        if (probing_table_ptr[index] == EMPTY_SLOT) {
-            probing_table_ptr[index] = key;
+    if ((size & (size - 1)) == 0) {
+        size_t mask = size - 1;
+        for (size_t step = 1; step <= size; step++) {
+            probes++;
+            uint64_t slot = ctx->probing_table[index];
+            if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+                ctx->probing_table[index] = key;
+                return probes;
+            }
+            index = (index + step) & mask;
+        }
+        return probes;
+    }
+    for (size_t step = 1; step <= size; step++) {
+        probes++;
+        uint64_t slot = ctx->probing_table[index];
+        if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+            ctx->probing_table[index] = key;
             return probes;
         }
+        index += step;
+        if (index >= size) { index -= size; } // index < size and step <= size
     }
     return probes;
 }
 
 // 4. Double Hashing
-long insert_double_hashing(int key) {
-    int initial_index = hash1(key);
-    int step = hash2(key);
+long insert_double_hashing(TableCtx *ctx, uint64_t key) {
+    size_t initial_index = hash1(ctx, key);
+    size_t step = hash2(ctx, key);
     long probes = 0;
 
-    for (int i = 0; i < current_table_size; i++) {
+    for (size_t i = 0; i < ctx->table_size; i++) {
         probes++;
-        int index = (initial_index + i * step) % current_table_size;
+        size_t index = (initial_index + i * step) % ctx->table_size;
 
-        if (probing_table_ptr[index] == EMPTY_SLOT) {
-            probing_table_ptr[index] = key;
+        uint64_t slot = ctx->probing_table[index];
+        if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+            ctx->probing_table[index] = key;
             return probes;
         }
     }
     return probes;
 }
 
-// --- Simulation Driver ---
+// 5. Metadata-Separated Linear Probing (Swiss-table style)
+// Linear probing where occupancy lives in the 1-byte meta_table: a
+// probe reads one control byte, not a 4-byte key slot, so the scan
+// stays inside far fewer cache lines. The stored tag is a 7-bit hash
+// fragment that later lets lookups reject non-matching slots without
+// touching the key array.
+long insert_meta_probing(TableCtx *ctx, uint64_t key) {
+    size_t initial_index = hash1(ctx, key);
+    unsigned char tag = (unsigned char)((key >> 7) & 0x7F);
+    long probes = 0;
 
-void run_simulation(const char* scale_name, const char* distribution_name, int (*key_generator)(int), int num_keys, int table_size) {
-    
-    initialize_tables(table_size);
-
-    long total_probes_chaining = 0;
-    long total_probes_lp = 0;
-    long total_probes_qp = 0;
-    long total_probes_dh = 0;
-
-    clock_t start_time, end_time;
-    double total_time_chaining = 0.0;
-    double total_time_lp = 0.0;
-    double total_time_qp = 0.0;
-    double total_time_dh = 0.0;
-
-    int print_step = (num_keys > 50) ? (num_keys / LOAD_FACTOR_STEPS) : 1;
-    if (num_keys <= MICRO_SIZE) { print_step = 1; }
-
-    for (int i = 0; i < num_keys; i++) {
-        int key = key_generator(i);
-        long probes;
-        double cpu_time_used;
-
-        if (i % print_step == 0 || i == num_keys - 1 || i < MICRO_SIZE) {
-            // --- Separate Chaining ---
-            start_time = clock();
-            probes = insert_chaining(key);
-            end_time = clock();
-            total_probes_chaining += probes;
-            cpu_time_used = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-            total_time_chaining += cpu_time_used * 1000.0; // ms
-
-            // --- Linear Probing ---
-            start_time = clock();
-            probes = insert_linear_probing(key);
-            end_time = clock();
-            total_probes_lp += probes;
-            cpu_time_used = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-            total_time_lp += cpu_time_used * 1000.0;
-
-            // --- Quadratic Probing ---
-            start_time = clock();
-            probes = insert_quadratic_probing(key);
-            end_time = clock();
-            total_probes_qp += probes;
-            cpu_time_used = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-            total_time_qp += cpu_time_used * 1000.0;
-
-            // --- Double Hashing ---
-            start_time = clock();
-            probes = insert_double_hashing(key);
-            end_time = clock();
-            total_probes_dh += probes;
-            cpu_time_used = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-            total_time_dh += cpu_time_used * 1000.0;
-
-            double load_factor = (double)(i + 1) / table_size;
-
-            // Print output in CSV format
-            printf("%d,%.6f,%s,%s,%ld,%ld,%ld,%ld,%.6f,%.6f,%.6f,%.6f\n",
-                   i + 1, // Key_Index
-                   load_factor,
-                   scale_name,
-                   distribution_name,
-                   total_probes_chaining,
-                   total_probes_lp,
-                   total_probes_qp,
-                   total_probes_dh,
-                   total_time_chaining,
-                   total_time_lp,
-                   total_time_qp,
-                   total_time_dh
-            );
-        } else {
-            // Insert without printing to keep metrics accurate
-            total_probes_chaining += insert_chaining(key);
-            total_probes_lp += insert_linear_probing(key);
-            total_probes_qp += insert_quadratic_probing(key);
-            total_probes_dh += insert_double_hashing(key);
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i) % ctx->table_size;
+
+        // Top bit set means empty or tombstone, either is insertable.
+        if (ctx->meta_table[index] & 0x80) {
+            ctx->meta_table[index] = tag;
+            ctx->probing_table[index] = key;
+            return probes;
+        }
+    }
+    return probes;
+}
+
+// 6. SIMD-Accelerated Linear Probing
+// Same probe sequence as linear probing, but the empty-slot scan
+// compares 4 uint64 slots per AVX2 instruction. The implementation is
+// picked once at startup: AVX2 when the CPU reports it, otherwise a
+// scalar scan with identical semantics.
+
+// Returns the offset of the first insertable slot (EMPTY_SLOT or
+// DELETED_SLOT tombstone) in [start, end), or -1.
+static long probe_scan_scalar(const uint64_t *table, size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+        if (table[i] == EMPTY_SLOT || table[i] == DELETED_SLOT) { return (long)i; }
+    }
+    return -1;
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+static long probe_scan_avx2(const uint64_t *table, size_t start, size_t end) {
+    const __m256i empty = _mm256_set1_epi64x((long long)EMPTY_SLOT);
+    const __m256i deleted = _mm256_set1_epi64x((long long)DELETED_SLOT);
+    size_t i = start;
+    for (; i + 4 <= end; i += 4) {
+        __m256i slots = _mm256_loadu_si256((const __m256i*)(table + i));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi64(slots, empty),
+                                       _mm256_cmpeq_epi64(slots, deleted));
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(hits));
+        if (mask != 0) { return (long)i + __builtin_ctz(mask); }
+    }
+    for (; i < end; i++) {
+        if (table[i] == EMPTY_SLOT || table[i] == DELETED_SLOT) { return (long)i; }
+    }
+    return -1;
+}
+#endif
+
+typedef long (*probe_scan_fn)(const uint64_t *table, size_t start, size_t end);
+static probe_scan_fn probe_scan = probe_scan_scalar;
+
+// CPUID-based dispatch, called once before any simulation starts.
+static void select_probe_scan(void) {
+#ifdef HAVE_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        probe_scan = probe_scan_avx2;
+    }
+#endif
+}
+
+long insert_simd_probing(TableCtx *ctx, uint64_t key) {
+    size_t start = hash1(ctx, key);
+
+    long found = probe_scan(ctx->probing_table, start, ctx->table_size);
+    if (found >= 0) {
+        ctx->probing_table[found] = key;
+        return found - (long)start + 1;
+    }
+
+    // Wrap around to the front of the table.
+    found = probe_scan(ctx->probing_table, 0, start);
+    if (found >= 0) {
+        ctx->probing_table[found] = key;
+        return (long)(ctx->table_size - start) + found + 1;
+    }
+
+    return (long)ctx->table_size; // table full, every slot examined
+}
+
+// 7. Robin Hood Hashing
+// Linear probing where the incoming key evicts any resident whose
+// displacement from its home slot is smaller ("rob the rich"). Mean
+// probe count matches linear probing, but the probe-length variance it
+// exists to bound shows up in the Probe_Max/Probe_Var columns.
+long insert_robin_hood(TableCtx *ctx, uint64_t key) {
+    uint64_t cur = key;
+    size_t pos = hash1(ctx, cur);
+    long dist = 0;
+    long probes = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        uint64_t slot = ctx->probing_table[pos];
+
+        if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+            ctx->probing_table[pos] = cur;
+            return probes;
+        }
+
+        long resident_dist = (long)pos - (long)hash1(ctx, slot);
+        if (resident_dist < 0) { resident_dist += (long)ctx->table_size; }
+        if (resident_dist < dist) {
+            ctx->probing_table[pos] = cur;
+            cur = slot;
+            dist = resident_dist;
+        }
+
+        dist++;
+        pos++;
+        if (pos == ctx->table_size) { pos = 0; }
+    }
+    return probes;
+}
+
+// 8. Cuckoo Hashing
+// Two tables packed into one array: nest 0 addresses the lower half,
+// nest 1 the upper half, which bounds successful lookups at two probes
+// plus the stash. hash2's legacy 1..7 step cannot address a second
+// table, so both nests use dedicated finalizer-style mixers
+// independent of --hash.
+static uint64_t cuckoo_mix(uint64_t k, uint64_t salt) {
+    k ^= salt;
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+static size_t cuckoo_slot(const TableCtx *ctx, uint64_t key, int nest) {
+    size_t half = ctx->table_size / 2;
+    uint64_t h = cuckoo_mix(key, nest ? 0x9e3779b97f4a7c15ull : 0u);
+    return (size_t)(nest ? half : 0) + (size_t)(h % (uint64_t)half);
+}
+
+long insert_cuckoo(TableCtx *ctx, uint64_t key) {
+    long probes = 0;
+    uint64_t cur = key;
+    int nest = 0;
+    size_t half = ctx->table_size / 2;
+
+    // Each round examines cur's nest; an occupied slot evicts its
+    // resident to the resident's other nest ("kicks"), so probes here
+    // measures the displacement-chain length.
+    for (int kick = 0; kick < CUCKOO_MAX_KICKS; kick++) {
+        size_t pos = cuckoo_slot(ctx, cur, nest);
+        probes++;
+        uint64_t slot = ctx->probing_table[pos];
+        if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+            ctx->probing_table[pos] = cur;
+            return probes;
+        }
+        ctx->probing_table[pos] = cur;
+        cur = slot;
+        nest = pos < half ? 1 : 0; // resident came from this nest, try its other
+    }
+
+    // Kick chain exceeded the bound: park the key in the stash, or
+    // count a failure that a real table would resolve by rehashing.
+    if (ctx->stash_used < CUCKOO_STASH) {
+        ctx->cuckoo_stash[ctx->stash_used++] = cur;
+    } else {
+        ctx->cuckoo_failures++;
+    }
+    return probes;
+}
+
+long lookup_cuckoo(TableCtx *ctx, uint64_t key, int *found) {
+    long probes = 0;
+    *found = 0;
+    for (int nest = 0; nest < 2; nest++) {
+        probes++;
+        if (ctx->probing_table[cuckoo_slot(ctx, key, nest)] == key) {
+            *found = 1;
+            return probes;
+        }
+    }
+    for (int s = 0; s < ctx->stash_used; s++) {
+        probes++;
+        if (ctx->cuckoo_stash[s] == key) {
+            ctx->stash_hits++;
+            *found = 1;
+            return probes;
+        }
+    }
+    return probes;
+}
+
+long delete_cuckoo(TableCtx *ctx, uint64_t key, int *found) {
+    long probes = 0;
+    *found = 0;
+    for (int nest = 0; nest < 2; nest++) {
+        probes++;
+        size_t pos = cuckoo_slot(ctx, key, nest);
+        if (ctx->probing_table[pos] == key) {
+            ctx->probing_table[pos] = EMPTY_SLOT; // direct addressing, no tombstone needed
+            *found = 1;
+            return probes;
+        }
+    }
+    for (int s = 0; s < ctx->stash_used; s++) {
+        probes++;
+        if (ctx->cuckoo_stash[s] == key) {
+            ctx->cuckoo_stash[s] = ctx->cuckoo_stash[--ctx->stash_used];
+            *found = 1;
+            return probes;
+        }
+    }
+    return probes;
+}
+
+// 9. Prefetching Chained Insertion
+// Identical layout and probe counts to Chaining; the walk issues a
+// software prefetch two links ahead so the next node's line is already
+// in flight while the current one is examined. Any delta against
+// Chaining in the time columns is therefore pure memory latency, not
+// algorithm.
+long insert_chaining_prefetch(TableCtx *ctx, uint64_t key) {
+    size_t index = hash1(ctx, key);
+    long probes = 1;
+
+    Node *newNode = arena_alloc_node(&ctx->node_arena);
+    if (newNode == NULL) { return 0; }
+
+    newNode->key = key;
+    newNode->next = NULL;
+
+    if (ctx->chaining_table[index] == NULL) {
+        ctx->chaining_table[index] = newNode;
+    } else {
+        Node *current = ctx->chaining_table[index];
+        while (current->next != NULL) {
+            __builtin_prefetch(current->next->next, 0, 1);
+            current = current->next;
+            probes++;
+        }
+        current->next = newNode;
+    }
+    return probes;
+}
+
+long lookup_chaining_prefetch(TableCtx *ctx, uint64_t key, int *found) {
+    long probes = 0;
+    *found = 0;
+
+    for (Node *current = ctx->chaining_table[hash1(ctx, key)];
+         current != NULL; current = current->next) {
+        if (current->next != NULL) {
+            __builtin_prefetch(current->next->next, 0, 1);
+        }
+        probes++;
+        if (current->key == key) {
+            *found = 1;
+            return probes;
         }
     }
-    cleanup_tables(table_size);
+    return probes;
 }
 
-int main() {
-    srand(time(NULL));
+// 10. Cell-Packed Chaining
+// Each bucket keeps CELL_CAP keys inline and only spills to chain
+// nodes beyond that, so the common case is one cache line with no
+// pointer chase. The inline scan counts as a single probe (one line,
+// like a Meta_Probing tag scan); each overflow node costs one more.
+long insert_cell_chaining(TableCtx *ctx, uint64_t key) {
+    CellBucket *bucket = &ctx->cell_table[hash1(ctx, key)];
+    long probes = 1;
+
+    if (bucket->count < CELL_CAP) {
+        bucket->keys[bucket->count++] = key;
+        return probes;
+    }
+
+    Node *newNode = arena_alloc_node(&ctx->node_arena);
+    if (newNode == NULL) { return 0; }
+    newNode->key = key;
+    newNode->next = NULL;
+    ctx->cell_overflow_nodes++;
 
-    // Print CSV Header
-    printf("Key_Index,Load_Factor,Scale,Distribution,Chaining_Probes,Linear_Probing_Probes,Quadratic_Probing_Probes,Double_Hashing_Probes,Chaining_Time_ms,Linear_Probing_Time_ms,Quadratic_Probing_Time_ms,Double_Hashing_Time_ms\n");
+    if (bucket->overflow == NULL) {
+        bucket->overflow = newNode;
+        return probes + 1;
+    }
+    Node *current = bucket->overflow;
+    probes++;
+    while (current->next != NULL) {
+        current = current->next;
+        probes++;
+    }
+    current->next = newNode;
+    return probes;
+}
 
-    // --- 1. Micro-Scale Simulations (10 Keys) ---
-    run_simulation("Micro", "Uniform", generate_uniform_key, MICRO_SIZE, MICRO_TABLE_SIZE);
-    run_simulation("Micro", "Skewed", generate_skewed_key, MICRO_SIZE, MICRO_TABLE_SIZE);
-    run_simulation("Micro", "Worst_Case", generate_worst_case_key, MICRO_SIZE, MICRO_TABLE_SIZE);
+long lookup_cell_chaining(TableCtx *ctx, uint64_t key, int *found) {
+    CellBucket *bucket = &ctx->cell_table[hash1(ctx, key)];
+    long probes = 1;
+    *found = 0;
 
-    // --- 2. Macro-Scale Simulations (10,000 Keys) ---
-    run_simulation("Macro", "Uniform", generate_uniform_key, NUM_INSERTIONS, TABLE_SIZE);
-    run_simulation("Macro", "Skewed", generate_skewed_key, NUM_INSERTIONS, TABLE_SIZE);
-    run_simulation("Macro", "Worst_Case", generate_worst_case_key, NUM_INSERTIONS, TABLE_SIZE);
+    for (int c = 0; c < bucket->count; c++) {
+        if (bucket->keys[c] == key) {
+            *found = 1;
+            return probes;
+        }
+    }
+    for (Node *current = bucket->overflow; current != NULL;
+         current = current->next) {
+        probes++;
+        if (current->key == key) {
+            *found = 1;
+            return probes;
+        }
+    }
+    return probes;
+}
+
+long delete_cell_chaining(TableCtx *ctx, uint64_t key, int *found) {
+    CellBucket *bucket = &ctx->cell_table[hash1(ctx, key)];
+    long probes = 1;
+    *found = 0;
+
+    for (int c = 0; c < bucket->count; c++) {
+        if (bucket->keys[c] == key) {
+            bucket->keys[c] = bucket->keys[--bucket->count];
+            *found = 1;
+            return probes;
+        }
+    }
+    Node **link = &bucket->overflow;
+    while (*link != NULL) {
+        probes++;
+        if ((*link)->key == key) {
+            *link = (*link)->next;
+            ctx->cell_overflow_nodes--;
+            *found = 1;
+            return probes;
+        }
+        link = &(*link)->next;
+    }
+    return probes;
+}
+
+// 11. Batched Linear Probing (software pipelined). One key at a time
+// leaves the memory system idle during every dependent probe; the
+// ingest pipeline instead hashes a group of keys up front, prefetches
+// all their initial buckets, then resolves collisions round-robin so
+// several probe sequences are in flight per core. Keys wait in
+// batch_buf until --batch-size accumulate; the flush returns the probe
+// total for the whole group, so the cumulative columns stay exact
+// while the per-window tail stats read lumpy for this variant.
+static int batch_size = 8; // --batch-size
+
+static long batch_flush(TableCtx *ctx) {
+    int n = ctx->batch_fill;
+    size_t index[BATCH_MAX];
+    long steps[BATCH_MAX];
+    int done[BATCH_MAX];
+
+    for (int i = 0; i < n; i++) {
+        index[i] = hash1(ctx, ctx->batch_buf[i]);
+        steps[i] = 0;
+        done[i] = 0;
+        __builtin_prefetch(&ctx->probing_table[index[i]], 1, 1);
+    }
+
+    long probes = 0;
+    int remaining = n;
+    while (remaining > 0) {
+        for (int i = 0; i < n; i++) {
+            if (done[i]) { continue; }
+            if (steps[i] == (long)ctx->table_size) {
+                done[i] = 1; // table full, same give-up as linear probing
+                remaining--;
+                continue;
+            }
+            probes++;
+            steps[i]++;
+            uint64_t slot = ctx->probing_table[index[i]];
+            if (slot == EMPTY_SLOT || slot == DELETED_SLOT) {
+                ctx->probing_table[index[i]] = ctx->batch_buf[i];
+                done[i] = 1;
+                remaining--;
+            } else {
+                index[i] = index[i] + 1 == ctx->table_size ? 0 : index[i] + 1;
+                __builtin_prefetch(&ctx->probing_table[index[i]], 1, 1);
+            }
+        }
+    }
+    ctx->batch_fill = 0;
+    return probes;
+}
+
+long insert_batched(TableCtx *ctx, uint64_t key) {
+    ctx->batch_buf[ctx->batch_fill++] = key;
+    if (ctx->batch_fill < batch_size) { return 0; }
+    return batch_flush(ctx);
+}
+
+typedef long (*insert_fn)(TableCtx *ctx, uint64_t key);
+
+static const insert_fn technique_inserts[NUM_TECHNIQUES] = {
+    insert_chaining,
+    insert_linear_probing,
+    insert_quadratic_probing,
+    insert_double_hashing,
+    insert_meta_probing,
+    insert_simd_probing,
+    insert_robin_hood,
+    insert_cuckoo,
+    insert_chaining_prefetch,
+    insert_cell_chaining,
+    insert_batched,
+    insert_triangular_probing
+};
+
+// --- Lookup and Delete Operations (Return Probes, set *found) ---
+
+// For open addressing, lookups probe past DELETED_SLOT tombstones and
+// only stop at a genuinely empty slot; deletes find the key and leave a
+// tombstone behind. Chaining deletes unlink the node (its memory stays
+// in the arena until the run ends).
+
+long lookup_chaining(TableCtx *ctx, uint64_t key, int *found) {
+    long probes = 0;
+    *found = 0;
+
+    for (Node *current = ctx->chaining_table[hash1(ctx, key)];
+         current != NULL; current = current->next) {
+        probes++;
+        if (current->key == key) {
+            *found = 1;
+            return probes;
+        }
+    }
+    return probes;
+}
+
+long delete_chaining(TableCtx *ctx, uint64_t key, int *found) {
+    size_t index = hash1(ctx, key);
+    long probes = 0;
+    *found = 0;
+
+    Node **link = &ctx->chaining_table[index];
+    while (*link != NULL) {
+        probes++;
+        if ((*link)->key == key) {
+            *link = (*link)->next;
+            *found = 1;
+            return probes;
+        }
+        link = &(*link)->next;
+    }
+    return probes;
+}
+
+long lookup_linear_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i) % ctx->table_size;
+        uint64_t slot = ctx->probing_table[index];
+
+        if (slot == key) { *found = 1; return probes; }
+        if (slot == EMPTY_SLOT) { return probes; }
+    }
+    return probes;
+}
+
+long delete_linear_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i) % ctx->table_size;
+        uint64_t slot = ctx->probing_table[index];
+
+        if (slot == key) {
+            ctx->probing_table[index] = DELETED_SLOT;
+            *found = 1;
+            return probes;
+        }
+        if (slot == EMPTY_SLOT) { return probes; }
+    }
+    return probes;
+}
+
+long lookup_quadratic_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i * i) % ctx->table_size;
+        uint64_t slot = ctx->probing_table[index];
+
+        if (slot == key) { *found = 1; return probes; }
+        if (slot == EMPTY_SLOT) { return probes; }
+    }
+    return probes;
+}
+
+long lookup_triangular_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t size = ctx->table_size;
+    size_t index = hash1(ctx, key);
+    long probes = 0;
+    *found = 0;
+    int pow2 = (size & (size - 1)) == 0;
+
+    for (size_t step = 1; step <= size; step++) {
+        probes++;
+        uint64_t slot = ctx->probing_table[index];
+        if (slot == key) { *found = 1; return probes; }
+        if (slot == EMPTY_SLOT) { return probes; }
+        if (pow2) {
+            index = (index + step) & (size - 1);
+        } else {
+            index += step;
+            if (index >= size) { index -= size; }
+        }
+    }
+    return probes;
+}
+
+long delete_triangular_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t size = ctx->table_size;
+    size_t index = hash1(ctx, key);
+    long probes = 0;
+    *found = 0;
+    int pow2 = (size & (size - 1)) == 0;
+
+    for (size_t step = 1; step <= size; step++) {
+        probes++;
+        uint64_t slot = ctx->probing_table[index];
+        if (slot == key) {
+            ctx->probing_table[index] = DELETED_SLOT;
+            *found = 1;
+            return probes;
+        }
+        if (slot == EMPTY_SLOT) { return probes; }
+        if (pow2) {
+            index = (index + step) & (size - 1);
+        } else {
+            index += step;
+            if (index >= size) { index -= size; }
+        }
+    }
+    return probes;
+}
+
+long delete_quadratic_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i * i) % ctx->table_size;
+        uint64_t slot = ctx->probing_table[index];
+
+        if (slot == key) {
+            ctx->probing_table[index] = DELETED_SLOT;
+            *found = 1;
+            return probes;
+        }
+        if (slot == EMPTY_SLOT) { return probes; }
+    }
+    return probes;
+}
+
+long lookup_double_hashing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    size_t step = hash2(ctx, key);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i * step) % ctx->table_size;
+        uint64_t slot = ctx->probing_table[index];
+
+        if (slot == key) { *found = 1; return probes; }
+        if (slot == EMPTY_SLOT) { return probes; }
+    }
+    return probes;
+}
+
+long delete_double_hashing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    size_t step = hash2(ctx, key);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i * step) % ctx->table_size;
+        uint64_t slot = ctx->probing_table[index];
+
+        if (slot == key) {
+            ctx->probing_table[index] = DELETED_SLOT;
+            *found = 1;
+            return probes;
+        }
+        if (slot == EMPTY_SLOT) { return probes; }
+    }
+    return probes;
+}
+
+// Meta probing checks the control byte first: a mismatched tag rejects
+// the slot without touching the key array.
+long lookup_meta_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    unsigned char tag = (unsigned char)((key >> 7) & 0x7F);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i) % ctx->table_size;
+        unsigned char meta = ctx->meta_table[index];
+
+        if (meta == tag && ctx->probing_table[index] == key) {
+            *found = 1;
+            return probes;
+        }
+        if (meta == META_EMPTY) { return probes; }
+    }
+    return probes;
+}
+
+long delete_meta_probing(TableCtx *ctx, uint64_t key, int *found) {
+    size_t initial_index = hash1(ctx, key);
+    unsigned char tag = (unsigned char)((key >> 7) & 0x7F);
+    long probes = 0;
+    *found = 0;
+
+    for (size_t i = 0; i < ctx->table_size; i++) {
+        probes++;
+        size_t index = (initial_index + i) % ctx->table_size;
+        unsigned char meta = ctx->meta_table[index];
+
+        if (meta == tag && ctx->probing_table[index] == key) {
+            ctx->meta_table[index] = META_DELETED;
+            *found = 1;
+            return probes;
+        }
+        if (meta == META_EMPTY) { return probes; }
+    }
+    return probes;
+}
+
+// The batched variant stores a plain linear layout, but keys can still
+// be waiting in batch_buf; a lookup or delete scans the buffer first
+// so pending keys are never reported missing.
+long lookup_batched(TableCtx *ctx, uint64_t key, int *found) {
+    for (int i = 0; i < ctx->batch_fill; i++) {
+        if (ctx->batch_buf[i] == key) {
+            *found = 1;
+            return 1;
+        }
+    }
+    return lookup_linear_probing(ctx, key, found);
+}
+
+long delete_batched(TableCtx *ctx, uint64_t key, int *found) {
+    for (int i = 0; i < ctx->batch_fill; i++) {
+        if (ctx->batch_buf[i] == key) {
+            ctx->batch_buf[i] = ctx->batch_buf[--ctx->batch_fill];
+            *found = 1;
+            return 1;
+        }
+    }
+    return delete_linear_probing(ctx, key, found);
+}
+
+typedef long (*lookup_fn)(TableCtx *ctx, uint64_t key, int *found);
+
+static const lookup_fn technique_lookups[NUM_TECHNIQUES] = {
+    lookup_chaining,
+    lookup_linear_probing,
+    lookup_quadratic_probing,
+    lookup_double_hashing,
+    lookup_meta_probing,
+    lookup_linear_probing, // SIMD probing stores plain linear layout
+    lookup_linear_probing, // Robin Hood layout is lookup-compatible
+    lookup_cuckoo,
+    lookup_chaining_prefetch,
+    lookup_cell_chaining,
+    lookup_batched,
+    lookup_triangular_probing
+};
+
+static const lookup_fn technique_deletes[NUM_TECHNIQUES] = {
+    delete_chaining,
+    delete_linear_probing,
+    delete_quadratic_probing,
+    delete_double_hashing,
+    delete_meta_probing,
+    delete_linear_probing,
+    delete_linear_probing,
+    delete_cuckoo,
+    delete_chaining, // prefetch variant shares the node layout
+    delete_cell_chaining,
+    delete_batched,
+    delete_triangular_probing
+};
+
+// --- Simulation Driver ---
+
+// One CSV output row: cumulative probes and time per technique at a
+// sampled insertion index. Techniques fill disjoint columns, so the
+// per-technique workers can share a row array without locking.
+// Per-window probe-length histogram: probe counts 1..62 map straight
+// to their bucket, the last bucket absorbs everything longer. Small
+// enough to stay cache-resident during the insert loop, wide enough
+// that p99/p999 land in a real bucket at any sane load factor.
+#define PROBE_HIST_BUCKETS 64
+
+typedef struct {
+    long key_index;
+    double load_factor;
+    long probes[NUM_TECHNIQUES];
+    double time_ms[NUM_TECHNIQUES];
+    double ns_per_op[NUM_TECHNIQUES]; // amortized insert cost so far
+    // Distribution of ns_per_op across --reps runs (equal to the mean
+    // with a single rep, stddev zero).
+    double ns_per_op_median[NUM_TECHNIQUES];
+    double ns_per_op_p99[NUM_TECHNIQUES];
+    double ns_per_op_stddev[NUM_TECHNIQUES];
+    // Probe-length tail statistics over the window since the previous
+    // sample point; means hide exactly the tails these expose.
+    long probe_max[NUM_TECHNIQUES];
+    double probe_var[NUM_TECHNIQUES];
+    // Cumulative hardware counters over the insert batches (--perf;
+    // zero when counters are disabled or unavailable).
+    long l1_misses[NUM_TECHNIQUES];
+    long llc_misses[NUM_TECHNIQUES];
+    long branch_misses[NUM_TECHNIQUES];
+    long cycles[NUM_TECHNIQUES];
+    // Mixed-workload metrics (zero unless --workload enables
+    // lookup/delete phases).
+    long lookup_probes[NUM_TECHNIQUES];
+    double lookup_time_ms[NUM_TECHNIQUES];
+    long delete_probes[NUM_TECHNIQUES];
+    double delete_time_ms[NUM_TECHNIQUES];
+    // Rehash cost accumulated by the growth policy (--grow-at).
+    long migration_probes[NUM_TECHNIQUES];
+    double migration_time_ms[NUM_TECHNIQUES];
+    // Failed-lookup batch at this checkpoint: average and max probes
+    // and amortized cost over MISS_LOOKUP_BATCH absent keys.
+    double miss_probes_avg[NUM_TECHNIQUES];
+    long miss_probes_max[NUM_TECHNIQUES];
+    double miss_ns_per_op[NUM_TECHNIQUES];
+    // Cuckoo instrumentation: cumulative rehash-triggering insert
+    // failures and stash hits (zero for every other technique).
+    long insert_failures[NUM_TECHNIQUES];
+    long stash_hits[NUM_TECHNIQUES];
+    // Modeled footprint at this fill (see technique_bytes).
+    long mem_bytes[NUM_TECHNIQUES];
+    long mem_overhead[NUM_TECHNIQUES];
+    double bytes_per_key[NUM_TECHNIQUES];
+    // Probe-length histogram over the window since the previous sample
+    // point (--hist-out sidecar); sums feed CCDF and percentile plots
+    // that the averaged columns cannot express.
+    long probe_hist[NUM_TECHNIQUES][PROBE_HIST_BUCKETS];
+} SampleRow;
+
+// --- Trace Replay (--trace) ---
+
+// Replays a binary key trace (little-endian uint64 per key) in place of
+// the synthetic generators, for workloads whose temporal skew none of
+// them model. The file is memory-mapped read-only and advised
+// sequential, so traces far larger than RAM stream through the page
+// cache with no per-key syscall or parse step between the keys and the
+// insert loop.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uint64_t *trace_keys = NULL;
+static long trace_num_keys = 0;
+static size_t trace_map_len = 0;
+
+static void trace_open(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot open trace file: %s\n", path);
+        exit(1);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(uint64_t)) {
+        fprintf(stderr, "Trace file is empty or unreadable: %s\n", path);
+        exit(1);
+    }
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Cannot map trace file: %s\n", path);
+        exit(1);
+    }
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    trace_keys = (uint64_t*)map;
+    trace_num_keys = (long)(st.st_size / (off_t)sizeof(uint64_t));
+    trace_map_len = (size_t)st.st_size;
+}
+
+static void trace_close(void) {
+    if (trace_keys != NULL) {
+        munmap(trace_keys, trace_map_len);
+        trace_keys = NULL;
+    }
+}
+
+// --- Memory Accounting ---
+
+// Models the footprint a technique would have in a fresh process at its
+// current fill: slot arrays at the live table size (both generations
+// while a grow is migrating), chain nodes at one slab per
+// ARENA_SLAB_NODES keys, and MALLOC_HEADER bytes of allocator metadata
+// per block. Modeled rather than measured because all techniques share
+// one process (and reused arenas) here, so resident-set deltas cannot
+// be attributed per technique. Overhead is everything beyond the
+// sizeof(uint64_t) payload per stored key.
+#define MALLOC_HEADER 16
+
+static long technique_bytes(const TableCtx *ctx, Technique tech,
+                            long stored, long *overhead_out) {
+    long slots = (long)ctx->table_size;
+    if (ctx->migrating) { slots += ctx->old_size; }
+
+    long bytes = 0;
+    if (tech == TECH_CHAINING || tech == TECH_PREFETCH_CHAIN) {
+        long slabs = (stored + ARENA_SLAB_NODES - 1) / ARENA_SLAB_NODES;
+        bytes = slots * (long)sizeof(Node*) + MALLOC_HEADER
+              + slabs * ((long)sizeof(ArenaSlab) + MALLOC_HEADER);
+    } else if (tech == TECH_CELL_CHAIN) {
+        long spilled = ctx->cell_overflow_nodes;
+        long slabs = spilled > 0 ? (spilled + ARENA_SLAB_NODES - 1) / ARENA_SLAB_NODES : 0;
+        bytes = slots * (long)sizeof(CellBucket) + MALLOC_HEADER
+              + slabs * ((long)sizeof(ArenaSlab) + MALLOC_HEADER);
+    } else if (tech == TECH_META) {
+        bytes = slots * (long)(sizeof(uint64_t) + sizeof(unsigned char))
+              + 2 * MALLOC_HEADER;
+    } else {
+        bytes = slots * (long)sizeof(uint64_t) + MALLOC_HEADER;
+    }
+
+    *overhead_out = bytes - stored * (long)sizeof(uint64_t);
+    return bytes;
+}
+
+// One (scale, distribution) cell. Keys are pre-generated once so every
+// technique inserts the identical key stream regardless of thread
+// scheduling.
+typedef struct {
+    const char *scale_name;
+    const char *distribution_name;
+    uint64_t (*key_generator)(Rng*, long);
+    uint64_t rng_stream; // distinct sub-stream of --seed per scenario
+    long num_keys;
+    size_t table_size;
+    uint64_t *keys;
+    int keys_mapped; // keys point into the trace mapping, not malloc
+    int num_samples;
+    SampleRow *rows;
+} Scenario;
+
+// Runtime-configurable knobs (see parse_args); defaults preserve the
+// historical compile-time behaviour.
+static int load_factor_steps = LOAD_FACTOR_STEPS;
+static unsigned int technique_mask = (1u << NUM_TECHNIQUES) - 1;
+
+// Repetition harness (--reps N --warmup M): each (scenario, technique)
+// cell re-runs in-process, reusing its TableCtx so repeats cost a reset
+// (table_ctx_prepare's memset path) instead of a realloc cycle. Warm-up
+// runs are discarded; over the recorded runs the timing columns hold
+// the mean and the ns/op distribution is summarised per sample point.
+static int bench_reps = 1;
+static int bench_warmup = 0;
+
+// Mixed-workload ratios (--workload I:L:D): after every
+// workload_insert inserts, issue workload_lookup lookups (alternating
+// present/absent keys) and workload_delete deletes. The default 1:0:0
+// reproduces the pure-insert behaviour.
+static int workload_insert = 1;
+static int workload_lookup = 0;
+static int workload_delete = 0;
+
+// Absent keys probed per sample checkpoint: unsuccessful searches are
+// the open-addressing worst case (probe until an empty slot) and
+// diverge from insert cost as the table fills, so each checkpoint
+// times a small batch of guaranteed-absent keys per technique.
+#define MISS_LOOKUP_BATCH 64
+
+// Deterministic index picker for workload targets, so every technique
+// replays the identical lookup/delete schedule without consuming the
+// scenario's key stream.
+static unsigned int workload_pick(unsigned int salt, unsigned int range) {
+    return (salt * 2654435761u) % range;
+}
+
+// Monotonic wall clock in nanoseconds. One insert takes tens of ns
+// while clock() ticks in microseconds, so operations are timed in
+// batches between checkpoints rather than one clock() pair per call.
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// --- Hardware Performance Counters (--perf) ---
+
+// Probe counts alone don't explain wall time: one chaining probe is a
+// dependent pointer chase while one linear probe is a sequential
+// cache-line read. --perf wraps each insert batch in perf_event_open
+// counters (Linux only) so misses-per-insert can be charted next to
+// probes-per-insert. Counters are opened per worker thread and enabled
+// only while an insert batch runs; if the kernel refuses access
+// (perf_event_paranoid) the columns stay zero and a warning is printed
+// once.
+static int perf_enabled = 0;
+
+enum { PERF_SLOT_L1 = 0, PERF_SLOT_LLC, PERF_SLOT_BRANCH, PERF_SLOT_CYCLES, NUM_PERF_SLOTS };
+
+typedef struct {
+    int fds[NUM_PERF_SLOTS];
+} PerfGroup;
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int perf_open_counter(unsigned int type, unsigned long long config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void perf_group_open(PerfGroup *pg) {
+    pg->fds[PERF_SLOT_L1] = perf_open_counter(PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_L1D |
+        (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    pg->fds[PERF_SLOT_LLC] = perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    pg->fds[PERF_SLOT_BRANCH] = perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    pg->fds[PERF_SLOT_CYCLES] = perf_open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+
+    static int warned = 0;
+    for (int s = 0; s < NUM_PERF_SLOTS; s++) {
+        if (pg->fds[s] < 0 && !warned) {
+            warned = 1;
+            fprintf(stderr, "perf_event_open unavailable (check /proc/sys/kernel/perf_event_paranoid); hardware counter columns will be zero.\n");
+        }
+    }
+}
+
+static void perf_group_enable(PerfGroup *pg) {
+    for (int s = 0; s < NUM_PERF_SLOTS; s++) {
+        if (pg->fds[s] >= 0) { ioctl(pg->fds[s], PERF_EVENT_IOC_ENABLE, 0); }
+    }
+}
+
+static void perf_group_disable(PerfGroup *pg) {
+    for (int s = 0; s < NUM_PERF_SLOTS; s++) {
+        if (pg->fds[s] >= 0) { ioctl(pg->fds[s], PERF_EVENT_IOC_DISABLE, 0); }
+    }
+}
+
+// Counters accumulate across enable/disable pairs, so one read at each
+// sample point yields the cumulative count over all insert batches.
+static void perf_group_read(PerfGroup *pg, long counts[NUM_PERF_SLOTS]) {
+    for (int s = 0; s < NUM_PERF_SLOTS; s++) {
+        long long value = 0;
+        if (pg->fds[s] >= 0 &&
+            read(pg->fds[s], &value, sizeof(value)) == sizeof(value)) {
+            counts[s] = (long)value;
+        } else {
+            counts[s] = 0;
+        }
+    }
+}
+
+static void perf_group_close(PerfGroup *pg) {
+    for (int s = 0; s < NUM_PERF_SLOTS; s++) {
+        if (pg->fds[s] >= 0) { close(pg->fds[s]); }
+    }
+}
+#else
+// Non-Linux builds keep the schema but report zeros.
+static void perf_group_open(PerfGroup *pg) {
+    static int warned = 0;
+    for (int s = 0; s < NUM_PERF_SLOTS; s++) { pg->fds[s] = -1; }
+    if (!warned) {
+        warned = 1;
+        fprintf(stderr, "--perf requires Linux perf_event_open; hardware counter columns will be zero.\n");
+    }
+}
+static void perf_group_enable(PerfGroup *pg) { (void)pg; }
+static void perf_group_disable(PerfGroup *pg) { (void)pg; }
+static void perf_group_read(PerfGroup *pg, long counts[NUM_PERF_SLOTS]) {
+    (void)pg;
+    for (int s = 0; s < NUM_PERF_SLOTS; s++) { counts[s] = 0; }
+}
+static void perf_group_close(PerfGroup *pg) { (void)pg; }
+#endif
+
+// --- Growth Policy (Resizing) ---
+
+// --grow-at ALPHA doubles the table when the live load factor crosses
+// the threshold: either stop-the-world (all buckets rehashed at the
+// trigger insert) or incrementally (--grow-mode incremental), moving at
+// most migrate_step old buckets per subsequent insert.
+static double grow_at = 0.0; // 0 disables resizing
+static int grow_incremental = 0;
+static int migrate_step = 8;
+
+// Temporary view of the previous generation so the per-technique
+// lookup/delete functions can run against the old arrays unchanged.
+static TableCtx old_generation_view(const TableCtx *ctx) {
+    TableCtx view = *ctx;
+    view.table_size = ctx->old_size;
+    view.chaining_table = ctx->old_chaining;
+    view.probing_table = ctx->old_probing;
+    view.meta_table = ctx->old_meta;
+    view.cell_table = ctx->old_cell;
+    view.migrating = 0;
+    return view;
+}
+
+// Swaps in freshly allocated arrays at twice the size; entries stay in
+// the old arrays until migrate_old_buckets moves them. Only the
+// layouts the running technique allocated exist, so only those grow.
+static void table_ctx_start_grow(TableCtx *ctx) {
+    size_t new_size = ctx->table_size * 2;
+
+    Node **new_chaining = NULL;
+    uint64_t *new_probing = NULL;
+    unsigned char *new_meta = NULL;
+    CellBucket *new_cell = NULL;
+    if (ctx->chaining_table != NULL) {
+        new_chaining = (Node**)table_alloc(sizeof(Node*) * new_size);
+    }
+    if (ctx->probing_table != NULL) {
+        new_probing = (uint64_t*)table_alloc(sizeof(uint64_t) * new_size);
+    }
+    if (ctx->meta_table != NULL) {
+        new_meta = (unsigned char*)table_alloc(sizeof(unsigned char) * new_size);
+    }
+    if (ctx->cell_table != NULL) {
+        new_cell = (CellBucket*)table_alloc(sizeof(CellBucket) * new_size);
+    }
+    if ((ctx->chaining_table != NULL && new_chaining == NULL) ||
+        (ctx->probing_table != NULL && new_probing == NULL) ||
+        (ctx->meta_table != NULL && new_meta == NULL) ||
+        (ctx->cell_table != NULL && new_cell == NULL)) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(1);
+    }
+    if (new_chaining != NULL) {
+        for (size_t i = 0; i < new_size; i++) { new_chaining[i] = NULL; }
+    }
+    if (new_probing != NULL) {
+        for (size_t i = 0; i < new_size; i++) { new_probing[i] = EMPTY_SLOT; }
+    }
+    if (new_meta != NULL) { memset(new_meta, META_EMPTY, new_size); }
+    if (new_cell != NULL) { memset(new_cell, 0, sizeof(CellBucket) * new_size); }
+
+    ctx->old_capacity = ctx->capacity;
+    ctx->old_size = ctx->table_size;
+    ctx->old_chaining = ctx->chaining_table;
+    ctx->old_probing = ctx->probing_table;
+    ctx->old_meta = ctx->meta_table;
+    ctx->old_cell = ctx->cell_table;
+    ctx->migrating = 1;
+    ctx->migrate_cursor = 0;
+
+    ctx->table_size = new_size;
+    ctx->capacity = new_size;
+    ctx->chaining_table = new_chaining;
+    ctx->probing_table = new_probing;
+    ctx->meta_table = new_meta;
+    ctx->cell_table = new_cell;
+}
+
+// Rehashes up to max_buckets old buckets into the current arrays
+// (max_buckets < 0 migrates everything). Reinsert probes accumulate in
+// migration_probes so rehash cost is attributable in the output.
+static void migrate_old_buckets(TableCtx *ctx, Technique tech, int max_buckets) {
+    insert_fn insert = technique_inserts[tech];
+    int moved = 0;
+
+    while (ctx->migrating && (max_buckets < 0 || moved < max_buckets)) {
+        size_t b = ctx->migrate_cursor;
+        if (tech == TECH_CHAINING || tech == TECH_PREFETCH_CHAIN) {
+            for (Node *current = ctx->old_chaining[b]; current != NULL;
+                 current = current->next) {
+                ctx->migration_probes += insert(ctx, current->key);
+            }
+        } else if (tech == TECH_CELL_CHAIN) {
+            CellBucket *bucket = &ctx->old_cell[b];
+            for (int c = 0; c < bucket->count; c++) {
+                ctx->migration_probes += insert(ctx, bucket->keys[c]);
+            }
+            for (Node *current = bucket->overflow; current != NULL;
+                 current = current->next) {
+                ctx->cell_overflow_nodes--;
+                ctx->migration_probes += insert(ctx, current->key);
+            }
+        } else if (tech == TECH_META) {
+            if (!(ctx->old_meta[b] & 0x80)) {
+                ctx->migration_probes += insert(ctx, ctx->old_probing[b]);
+            }
+        } else {
+            uint64_t slot = ctx->old_probing[b];
+            if (slot != EMPTY_SLOT && slot != DELETED_SLOT) {
+                ctx->migration_probes += insert(ctx, slot);
+            }
+        }
+        moved++;
+        ctx->migrate_cursor++;
+        if (ctx->migrate_cursor == ctx->old_size) {
+            table_ctx_drop_old(ctx);
+        }
+    }
+}
+
+// --- Driver-Level Operations ---
+
+// All driver operations go through these wrappers so the growth policy
+// sees every insert and lookups/deletes can fall back to a generation
+// that is still being migrated.
+
+static long driver_insert(TableCtx *ctx, Technique tech, uint64_t key) {
+    if (grow_at > 0.0) {
+        if (ctx->migrating) {
+            uint64_t start_ns = monotonic_ns();
+            migrate_old_buckets(ctx, tech, migrate_step);
+            ctx->migration_ns += monotonic_ns() - start_ns;
+        } else if ((double)(ctx->live_keys + 1) > grow_at * ctx->table_size) {
+            uint64_t start_ns = monotonic_ns();
+            table_ctx_start_grow(ctx);
+            if (!grow_incremental) {
+                migrate_old_buckets(ctx, tech, -1);
+            }
+            ctx->migration_ns += monotonic_ns() - start_ns;
+        }
+    }
+    ctx->live_keys++;
+    return technique_inserts[tech](ctx, key);
+}
+
+static long driver_lookup(TableCtx *ctx, Technique tech, uint64_t key, int *found) {
+    long probes = technique_lookups[tech](ctx, key, found);
+    if (!*found && ctx->migrating) {
+        TableCtx view = old_generation_view(ctx);
+        probes += technique_lookups[tech](&view, key, found);
+    }
+    return probes;
+}
+
+static long driver_delete(TableCtx *ctx, Technique tech, uint64_t key, int *found) {
+    long probes = technique_deletes[tech](ctx, key, found);
+    if (!*found && ctx->migrating) {
+        TableCtx view = old_generation_view(ctx);
+        probes += technique_deletes[tech](&view, key, found);
+        // Chaining deletes unlink via the bucket array, which the view
+        // shares with old_chaining, so the mutation lands correctly.
+    }
+    if (*found) { ctx->live_keys--; }
+    return probes;
+}
+
+// --- Checkpoint / Restore ---
+
+// Serializes per-technique table state at a chosen load factor so
+// incremental experiments (--restore) resume from a bulk read instead
+// of replaying every prior insert. Flat arrays are dumped raw; chains
+// are written as a packed (bucket, length, keys...) stream and rebuilt
+// straight out of the arena on restore, so loading is O(size) with no
+// rehashing. One file holds one section per technique.
+#define CKPT_MAGIC "HTCP"
+#define CKPT_VERSION 1
+#define CKPT_NAME_LEN 32
+#define CKPT_STREAM_END ((uint64_t)-1)
+
+static const char *hist_out = NULL; // --hist-out sidecar path
+static const char *checkpoint_out = NULL;
+static double checkpoint_at = 1.0; // load factor that triggers the dump
+static const char *restore_path = NULL;
+
+typedef struct __attribute__((packed)) {
+    char magic[4];
+    uint32_t version;
+} CkptHeader;
+
+typedef struct __attribute__((packed)) {
+    char technique[CKPT_NAME_LEN];
+    uint64_t table_size;
+    int64_t keys_inserted;   // position in the scenario key stream
+    int64_t live_keys;
+    int64_t cell_overflow_nodes;
+    int64_t cuckoo_failures;
+    int64_t stash_hits;
+    int32_t stash_used;
+    uint64_t cuckoo_stash[CUCKOO_STASH];
+    uint64_t payload_bytes;
+} CkptSection;
+
+static FILE *ckpt_file = NULL;
+static unsigned int ckpt_written_mask = 0;
+static pthread_mutex_t ckpt_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void ckpt_open(const char *path) {
+    ckpt_file = fopen(path, "wb");
+    if (ckpt_file == NULL) {
+        fprintf(stderr, "Cannot open %s for writing.\n", path);
+        exit(1);
+    }
+    CkptHeader header;
+    memcpy(header.magic, CKPT_MAGIC, 4);
+    header.version = CKPT_VERSION;
+    fwrite(&header, sizeof(header), 1, ckpt_file);
+}
+
+// Packed chain stream: (bucket, length, keys in chain order) per
+// non-empty bucket, terminated by CKPT_STREAM_END.
+static uint64_t ckpt_chain_bytes(Node *const *heads, size_t size) {
+    uint64_t bytes = sizeof(uint64_t); // terminator
+    for (size_t b = 0; b < size; b++) {
+        if (heads[b] == NULL) { continue; }
+        bytes += 2 * sizeof(uint64_t);
+        for (const Node *n = heads[b]; n != NULL; n = n->next) {
+            bytes += sizeof(uint64_t);
+        }
+    }
+    return bytes;
+}
+
+static void ckpt_write_chains(Node *const *heads, size_t size) {
+    for (size_t b = 0; b < size; b++) {
+        if (heads[b] == NULL) { continue; }
+        uint64_t len = 0;
+        for (const Node *n = heads[b]; n != NULL; n = n->next) { len++; }
+        uint64_t bucket = b;
+        fwrite(&bucket, sizeof(bucket), 1, ckpt_file);
+        fwrite(&len, sizeof(len), 1, ckpt_file);
+        for (const Node *n = heads[b]; n != NULL; n = n->next) {
+            fwrite(&n->key, sizeof(n->key), 1, ckpt_file);
+        }
+    }
+    uint64_t end = CKPT_STREAM_END;
+    fwrite(&end, sizeof(end), 1, ckpt_file);
+}
+
+static void ckpt_write_section(TableCtx *ctx, Technique tech, long keys_inserted) {
+    pthread_mutex_lock(&ckpt_lock);
+    if (ckpt_written_mask & (1u << tech)) {
+        pthread_mutex_unlock(&ckpt_lock);
+        return;
+    }
+
+    // Drain any in-flight incremental grow (and the batched variant's
+    // pending keys) so a single generation captures the whole table.
+    if (ctx->migrating) { migrate_old_buckets(ctx, tech, -1); }
+    if (tech == TECH_BATCH && ctx->batch_fill > 0) { batch_flush(ctx); }
+
+    size_t size = ctx->table_size;
+    CkptSection sec;
+    memset(&sec, 0, sizeof(sec));
+    strncpy(sec.technique, technique_names[tech], CKPT_NAME_LEN - 1);
+    sec.table_size = size;
+    sec.keys_inserted = keys_inserted;
+    sec.live_keys = ctx->live_keys;
+    sec.cell_overflow_nodes = ctx->cell_overflow_nodes;
+    sec.cuckoo_failures = ctx->cuckoo_failures;
+    sec.stash_hits = ctx->stash_hits;
+    sec.stash_used = ctx->stash_used;
+    memcpy(sec.cuckoo_stash, ctx->cuckoo_stash, sizeof(sec.cuckoo_stash));
+
+    if (tech == TECH_CHAINING || tech == TECH_PREFETCH_CHAIN) {
+        sec.payload_bytes = ckpt_chain_bytes(ctx->chaining_table, size);
+        fwrite(&sec, sizeof(sec), 1, ckpt_file);
+        ckpt_write_chains(ctx->chaining_table, size);
+    } else if (tech == TECH_CELL_CHAIN) {
+        // Inline cells as a packed stream, then the spilled chains.
+        uint64_t bytes = sizeof(uint64_t);
+        for (size_t b = 0; b < size; b++) {
+            if (ctx->cell_table[b].count > 0) {
+                bytes += (2 + (uint64_t)ctx->cell_table[b].count) * sizeof(uint64_t);
+            }
+        }
+        uint64_t overflow_bytes = sizeof(uint64_t);
+        for (size_t b = 0; b < size; b++) {
+            if (ctx->cell_table[b].overflow == NULL) { continue; }
+            overflow_bytes += 2 * sizeof(uint64_t);
+            for (const Node *n = ctx->cell_table[b].overflow; n != NULL; n = n->next) {
+                overflow_bytes += sizeof(uint64_t);
+            }
+        }
+        sec.payload_bytes = bytes + overflow_bytes;
+        fwrite(&sec, sizeof(sec), 1, ckpt_file);
+        for (size_t b = 0; b < size; b++) {
+            if (ctx->cell_table[b].count == 0) { continue; }
+            uint64_t bucket = b;
+            uint64_t len = (uint64_t)ctx->cell_table[b].count;
+            fwrite(&bucket, sizeof(bucket), 1, ckpt_file);
+            fwrite(&len, sizeof(len), 1, ckpt_file);
+            fwrite(ctx->cell_table[b].keys, sizeof(uint64_t), ctx->cell_table[b].count, ckpt_file);
+        }
+        uint64_t end = CKPT_STREAM_END;
+        fwrite(&end, sizeof(end), 1, ckpt_file);
+        for (size_t b = 0; b < size; b++) {
+            if (ctx->cell_table[b].overflow == NULL) { continue; }
+            uint64_t bucket = b;
+            uint64_t len = 0;
+            for (const Node *n = ctx->cell_table[b].overflow; n != NULL; n = n->next) { len++; }
+            fwrite(&bucket, sizeof(bucket), 1, ckpt_file);
+            fwrite(&len, sizeof(len), 1, ckpt_file);
+            for (const Node *n = ctx->cell_table[b].overflow; n != NULL; n = n->next) {
+                fwrite(&n->key, sizeof(n->key), 1, ckpt_file);
+            }
+        }
+        fwrite(&end, sizeof(end), 1, ckpt_file);
+    } else if (tech == TECH_META) {
+        sec.payload_bytes = size * (sizeof(uint64_t) + 1);
+        fwrite(&sec, sizeof(sec), 1, ckpt_file);
+        fwrite(ctx->probing_table, sizeof(uint64_t), size, ckpt_file);
+        fwrite(ctx->meta_table, 1, size, ckpt_file);
+    } else {
+        sec.payload_bytes = size * sizeof(uint64_t);
+        fwrite(&sec, sizeof(sec), 1, ckpt_file);
+        fwrite(ctx->probing_table, sizeof(uint64_t), size, ckpt_file);
+    }
+    fflush(ckpt_file);
+    ckpt_written_mask |= 1u << tech;
+    pthread_mutex_unlock(&ckpt_lock);
+}
+
+// The whole checkpoint file is slurped once at startup; per-technique
+// restore then works off the in-memory image.
+static unsigned char *restore_blob = NULL;
+static size_t restore_blob_size = 0;
+
+static void restore_open(const char *path) {
+    FILE *in = fopen(path, "rb");
+    if (in == NULL) {
+        fprintf(stderr, "Cannot open %s.\n", path);
+        exit(1);
+    }
+    fseek(in, 0, SEEK_END);
+    long file_size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    if (file_size < (long)sizeof(CkptHeader)) {
+        fprintf(stderr, "%s is not a checkpoint file.\n", path);
+        exit(1);
+    }
+    restore_blob = (unsigned char*)malloc(file_size);
+    if (restore_blob == NULL || fread(restore_blob, 1, file_size, in) != (size_t)file_size) {
+        fprintf(stderr, "Cannot read %s.\n", path);
+        exit(1);
+    }
+    fclose(in);
+    restore_blob_size = (size_t)file_size;
+
+    const CkptHeader *header = (const CkptHeader*)restore_blob;
+    if (memcmp(header->magic, CKPT_MAGIC, 4) != 0 || header->version != CKPT_VERSION) {
+        fprintf(stderr, "%s: bad checkpoint magic or version.\n", path);
+        exit(1);
+    }
+}
+
+static const unsigned char *restore_read_chains(const unsigned char *p, TableCtx *ctx,
+                                                int into_cells, long *node_count) {
+    for (;;) {
+        uint64_t bucket;
+        memcpy(&bucket, p, sizeof(bucket));
+        p += sizeof(bucket);
+        if (bucket == CKPT_STREAM_END) { return p; }
+        uint64_t len;
+        memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        Node *tail = NULL;
+        for (uint64_t k = 0; k < len; k++) {
+            Node *node = arena_alloc_node(&ctx->node_arena);
+            if (node == NULL) {
+                fprintf(stderr, "Memory allocation failed.\n");
+                exit(1);
+            }
+            memcpy(&node->key, p, sizeof(node->key));
+            p += sizeof(node->key);
+            node->next = NULL;
+            if (tail == NULL) {
+                if (into_cells) {
+                    ctx->cell_table[bucket].overflow = node;
+                } else {
+                    ctx->chaining_table[bucket] = node;
+                }
+            } else {
+                tail->next = node;
+            }
+            tail = node;
+            if (node_count != NULL) { (*node_count)++; }
+        }
+    }
+}
+
+// Loads the section for tech into ctx and returns the key-stream
+// position to resume from, or -1 when the file has no such section.
+// The caller must run with the same seed and generators the checkpoint
+// was taken under, or the resumed stream will not line up.
+static long ckpt_restore(TableCtx *ctx, Technique tech) {
+    size_t off = sizeof(CkptHeader);
+    while (off + sizeof(CkptSection) <= restore_blob_size) {
+        const CkptSection *sec = (const CkptSection*)(restore_blob + off);
+        const unsigned char *payload = restore_blob + off + sizeof(CkptSection);
+        if (strncmp(sec->technique, technique_names[tech], CKPT_NAME_LEN) != 0) {
+            off += sizeof(CkptSection) + sec->payload_bytes;
+            continue;
+        }
+
+        size_t size = (size_t)sec->table_size;
+        table_ctx_prepare(ctx, size, technique_layouts(tech));
+        ctx->live_keys = sec->live_keys;
+        ctx->cell_overflow_nodes = sec->cell_overflow_nodes;
+        ctx->cuckoo_failures = sec->cuckoo_failures;
+        ctx->stash_hits = sec->stash_hits;
+        ctx->stash_used = sec->stash_used;
+        memcpy(ctx->cuckoo_stash, sec->cuckoo_stash, sizeof(ctx->cuckoo_stash));
+
+        if (tech == TECH_CHAINING || tech == TECH_PREFETCH_CHAIN) {
+            restore_read_chains(payload, ctx, 0, NULL);
+        } else if (tech == TECH_CELL_CHAIN) {
+            const unsigned char *p = payload;
+            for (;;) {
+                uint64_t bucket;
+                memcpy(&bucket, p, sizeof(bucket));
+                p += sizeof(bucket);
+                if (bucket == CKPT_STREAM_END) { break; }
+                uint64_t len;
+                memcpy(&len, p, sizeof(len));
+                p += sizeof(len);
+                ctx->cell_table[bucket].count = (int)len;
+                memcpy(ctx->cell_table[bucket].keys, p, len * sizeof(uint64_t));
+                p += len * sizeof(uint64_t);
+            }
+            restore_read_chains(p, ctx, 1, NULL);
+        } else if (tech == TECH_META) {
+            memcpy(ctx->probing_table, payload, size * sizeof(uint64_t));
+            memcpy(ctx->meta_table, payload + size * sizeof(uint64_t), size);
+        } else {
+            memcpy(ctx->probing_table, payload, size * sizeof(uint64_t));
+        }
+        return (long)sec->keys_inserted;
+    }
+    return -1;
+}
+
+// --- Live Shared-Memory Ring (--shm-out) ---
+
+// Publishes one record per (sample window, technique) into a POSIX
+// shared-memory ring as soon as the window closes, so a dashboard can
+// attach to a running sweep and render partial results instead of
+// waiting hours for results_data.csv. The region is left in place at
+// exit for late attachers; remove it with shm_unlink or rm on
+// /dev/shm when the sweep is done.
+#define SHM_MAGIC "HTLV"
+#define SHM_VERSION 1
+#define SHM_NAME_LEN 32
+#define SHM_DEFAULT_CAPACITY 65536
+
+typedef struct __attribute__((packed)) {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t capacity;
+    uint64_t head; // total records ever published; slot = head % capacity
+} ShmHeader;
+
+typedef struct __attribute__((packed)) {
+    char scale[16]; // sweep names ("Size_1048576") overflow 8 bytes
+    char distribution[16];
+    char technique[SHM_NAME_LEN];
+    int64_t key_index;
+    double load_factor;
+    int64_t probes;
+    double time_ms;
+    double ns_per_op;
+    int64_t probe_max;
+    double probe_var;
+    double miss_probes_avg;
+    int64_t mem_bytes;
+    double bytes_per_key;
+} ShmRecord;
+
+static const char *shm_out_name = NULL; // --shm-out
+static ShmHeader *shm_header = NULL;
+static ShmRecord *shm_ring = NULL;
+static pthread_mutex_t shm_write_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void shm_ring_open(const char *name) {
+    size_t bytes = sizeof(ShmHeader) + (size_t)SHM_DEFAULT_CAPACITY * sizeof(ShmRecord);
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)bytes) != 0) {
+        fprintf(stderr, "Cannot create shared memory segment %s.\n", name);
+        exit(1);
+    }
+    void *map = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Cannot map shared memory segment %s.\n", name);
+        exit(1);
+    }
+    shm_header = (ShmHeader*)map;
+    shm_ring = (ShmRecord*)((unsigned char*)map + sizeof(ShmHeader));
+    memcpy(shm_header->magic, SHM_MAGIC, 4);
+    shm_header->version = SHM_VERSION;
+    shm_header->record_size = sizeof(ShmRecord);
+    shm_header->capacity = SHM_DEFAULT_CAPACITY;
+    // head last, with release semantics, so a reader that sees a valid
+    // header never reads an unpublished slot.
+    __atomic_store_n(&shm_header->head, 0, __ATOMIC_RELEASE);
+}
+
+static void shm_ring_publish(const Scenario *sc, Technique tech, const SampleRow *row) {
+    pthread_mutex_lock(&shm_write_lock);
+    uint64_t head = shm_header->head;
+    ShmRecord *rec = &shm_ring[head % shm_header->capacity];
+    memset(rec, 0, sizeof(*rec));
+    strncpy(rec->scale, sc->scale_name, sizeof(rec->scale) - 1);
+    strncpy(rec->distribution, sc->distribution_name, sizeof(rec->distribution) - 1);
+    strncpy(rec->technique, technique_names[tech], SHM_NAME_LEN - 1);
+    rec->key_index = row->key_index;
+    rec->load_factor = row->load_factor;
+    rec->probes = row->probes[tech];
+    rec->time_ms = row->time_ms[tech];
+    rec->ns_per_op = row->ns_per_op[tech];
+    rec->probe_max = row->probe_max[tech];
+    rec->probe_var = row->probe_var[tech];
+    rec->miss_probes_avg = row->miss_probes_avg[tech];
+    rec->mem_bytes = row->mem_bytes[tech];
+    rec->bytes_per_key = row->bytes_per_key[tech];
+    __atomic_store_n(&shm_header->head, head + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&shm_write_lock);
+}
+
+// Base sampling interval; micro scenarios fall out of the same
+// expression (num_keys <= 50 gives step 1) instead of the old special
+// case, so every caller goes through one predicate.
+static long scenario_print_step(const Scenario *sc) {
+    long print_step = (sc->num_keys > 50) ? (sc->num_keys / load_factor_steps) : 1;
+    return print_step < 1 ? 1 : print_step;
+}
+
+// Adaptive sampling density: a fixed interval wastes samples in the
+// flat low-load region and under-resolves the cliff above a~0.85
+// where the degradation actually happens. The interval halves each
+// time the remaining table capacity halves (a > 1/2, 3/4, 7/8,
+// 15/16), capped at four halvings, so the checkpoint density grows
+// geometrically toward full tables while total output stays within a
+// small multiple of --steps. Depends only on the key index, so every
+// technique samples the identical checkpoints and rows stay aligned.
+static int is_sample_point(const Scenario *sc, long print_step, long i) {
+    double alpha = (double)(i + 1) / (double)sc->table_size;
+    int level = 0;
+    if (alpha > 0.5)    { level = 1; }
+    if (alpha > 0.75)   { level = 2; }
+    if (alpha > 0.875)  { level = 3; }
+    if (alpha > 0.9375) { level = 4; }
+    long step = print_step >> level;
+    if (step < 1) { step = 1; }
+    return i % step == 0 || i == sc->num_keys - 1;
+}
+
+static void scenario_prepare(Scenario *sc) {
+    if (sc->key_generator == NULL) {
+        // Trace replay: the scenario reads keys straight out of the
+        // mapping, zero-copy.
+        if (sc->num_keys > trace_num_keys) { sc->num_keys = trace_num_keys; }
+        sc->keys = trace_keys;
+        sc->keys_mapped = 1;
+    } else {
+        sc->keys = (uint64_t*)malloc(sizeof(uint64_t) * sc->num_keys);
+        if (sc->keys == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(1);
+        }
+        Rng rng;
+        rng_init(&rng, rng_seed, sc->rng_stream);
+        key_gen_table_size = sc->table_size;
+        key_gen_universe = sc->num_keys;
+        for (long i = 0; i < sc->num_keys; i++) {
+            sc->keys[i] = sc->key_generator(&rng, i);
+        }
+    }
+
+    long print_step = scenario_print_step(sc);
+    sc->num_samples = 0;
+    for (long i = 0; i < sc->num_keys; i++) {
+        if (is_sample_point(sc, print_step, i)) { sc->num_samples++; }
+    }
+
+    sc->rows = (SampleRow*)calloc(sc->num_samples, sizeof(SampleRow));
+    if (sc->rows == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(1);
+    }
+
+    int sample = 0;
+    for (long i = 0; i < sc->num_keys; i++) {
+        if (is_sample_point(sc, print_step, i)) {
+            sc->rows[sample].key_index = i + 1;
+            sc->rows[sample].load_factor = (double)(i + 1) / (double)sc->table_size;
+            sample++;
+        }
+    }
+}
+
+static void scenario_release(Scenario *sc) {
+    if (!sc->keys_mapped) { free(sc->keys); }
+    free(sc->rows);
+}
+
+// Runs one technique over one scenario, recording cumulative
+// probes/time at each sample point. The caller owns ctx so table
+// memory can be reused across consecutive runs.
+void run_technique(Scenario *sc, Technique tech, TableCtx *ctx) {
+    table_ctx_prepare(ctx, sc->table_size, technique_layouts(tech));
+
+    long resume_at = 0;
+    if (restore_path != NULL) {
+        resume_at = ckpt_restore(ctx, tech);
+        if (resume_at < 0) {
+            fprintf(stderr, "%s: no %s section, starting cold.\n",
+                    restore_path, technique_names[tech]);
+            resume_at = 0;
+        }
+        if (resume_at > sc->num_keys) { resume_at = sc->num_keys; }
+    }
+
+    long print_step = scenario_print_step(sc);
+    int mixed = (workload_lookup > 0 || workload_delete > 0);
+
+    long total_probes = 0;
+    uint64_t total_insert_ns = 0;
+    long window_count = 0;
+    long window_sum = 0;
+    double window_sumsq = 0.0;
+    long window_max = 0;
+    long window_hist[PROBE_HIST_BUCKETS] = {0};
+    long total_lookup_probes = 0;
+    uint64_t total_lookup_ns = 0;
+    long total_delete_probes = 0;
+    uint64_t total_delete_ns = 0;
+    int sample = 0;
+
+    PerfGroup perf = {{0}};
+    if (perf_enabled) { perf_group_open(&perf); }
+
+    // Inserts run in batches between checkpoints with one monotonic
+    // clock pair per batch, so every insert goes through the identical
+    // code path and the amortized cost isn't swamped by timer
+    // granularity.
+    // Rows before the restore point stay zero (calloc) and samples
+    // re-align so the resumed phase lands in the right rows.
+    long i = resume_at;
+    for (long k = 0; k < resume_at; k++) {
+        if (is_sample_point(sc, print_step, k)) { sample++; }
+    }
+
+    while (i < sc->num_keys) {
+        // Extend the batch until it ends on a checkpoint: either a
+        // sample point or a mixed-workload boundary.
+        long batch_end = i;
+        while (!is_sample_point(sc, print_step, batch_end) &&
+               !(mixed && (batch_end + 1) % workload_insert == 0) &&
+               batch_end < sc->num_keys - 1) {
+            batch_end++;
+        }
+
+        if (perf_enabled) { perf_group_enable(&perf); }
+        uint64_t start_ns = monotonic_ns();
+        for (long k = i; k <= batch_end; k++) {
+            long p = driver_insert(ctx, tech, sc->keys[k]);
+            total_probes += p;
+            window_count++;
+            window_sum += p;
+            window_sumsq += (double)p * (double)p;
+            if (p > window_max) { window_max = p; }
+            window_hist[p < PROBE_HIST_BUCKETS ? p : PROBE_HIST_BUCKETS - 1]++;
+        }
+        total_insert_ns += monotonic_ns() - start_ns;
+        if (perf_enabled) { perf_group_disable(&perf); }
+
+        if (checkpoint_out != NULL && !(ckpt_written_mask & (1u << tech)) &&
+            (double)(batch_end + 1) >= checkpoint_at * (double)sc->table_size) {
+            ckpt_write_section(ctx, tech, batch_end + 1);
+        }
+
+        if (is_sample_point(sc, print_step, batch_end)) {
+            // Drain the pending batch so the cumulative columns and the
+            // checkpoint below cover every key inserted so far.
+            if (tech == TECH_BATCH && ctx->batch_fill > 0) {
+                long p = batch_flush(ctx);
+                total_probes += p;
+                window_count++;
+                window_sum += p;
+                window_sumsq += (double)p * (double)p;
+                if (p > window_max) { window_max = p; }
+                window_hist[p < PROBE_HIST_BUCKETS ? p : PROBE_HIST_BUCKETS - 1]++;
+            }
+
+            // Probe a batch of absent keys (complemented present keys
+            // are outside every generator's range) to measure the
+            // miss path at this fill. Lookups don't mutate the table,
+            // so the run itself is unaffected.
+            long miss_probes = 0;
+            long miss_max = 0;
+            int found;
+            uint64_t miss_start = monotonic_ns();
+            for (int b = 0; b < MISS_LOOKUP_BATCH; b++) {
+                uint64_t target = ~sc->keys[workload_pick((unsigned int)(batch_end + b),
+                                                          (unsigned int)(batch_end + 1))];
+                if (target >= DELETED_SLOT) { target -= 2; } // dodge the sentinels
+                long p = driver_lookup(ctx, tech, target, &found);
+                miss_probes += p;
+                if (p > miss_max) { miss_max = p; }
+            }
+            uint64_t miss_ns = monotonic_ns() - miss_start;
+            sc->rows[sample].miss_probes_avg[tech] = (double)miss_probes / MISS_LOOKUP_BATCH;
+            sc->rows[sample].miss_probes_max[tech] = miss_max;
+            sc->rows[sample].miss_ns_per_op[tech] = (double)miss_ns / MISS_LOOKUP_BATCH;
+
+            sc->rows[sample].probes[tech] = total_probes;
+            sc->rows[sample].time_ms[tech] = (double)total_insert_ns / 1e6;
+            sc->rows[sample].ns_per_op[tech] = (double)total_insert_ns / (double)(batch_end + 1);
+            double window_mean = (double)window_sum / (double)window_count;
+            sc->rows[sample].probe_max[tech] = window_max;
+            sc->rows[sample].probe_var[tech] =
+                window_sumsq / (double)window_count - window_mean * window_mean;
+            window_count = 0;
+            window_sum = 0;
+            window_sumsq = 0.0;
+            window_max = 0;
+            memcpy(sc->rows[sample].probe_hist[tech], window_hist, sizeof(window_hist));
+            memset(window_hist, 0, sizeof(window_hist));
+            sc->rows[sample].lookup_probes[tech] = total_lookup_probes;
+            sc->rows[sample].lookup_time_ms[tech] = (double)total_lookup_ns / 1e6;
+            sc->rows[sample].delete_probes[tech] = total_delete_probes;
+            sc->rows[sample].delete_time_ms[tech] = (double)total_delete_ns / 1e6;
+            sc->rows[sample].migration_probes[tech] = ctx->migration_probes;
+            sc->rows[sample].migration_time_ms[tech] = (double)ctx->migration_ns / 1e6;
+            sc->rows[sample].insert_failures[tech] = ctx->cuckoo_failures;
+            sc->rows[sample].stash_hits[tech] = ctx->stash_hits;
+            {
+                long stored = ctx->live_keys > 0 ? ctx->live_keys : batch_end + 1;
+                long overhead;
+                long bytes = technique_bytes(ctx, tech, stored, &overhead);
+                sc->rows[sample].mem_bytes[tech] = bytes;
+                sc->rows[sample].mem_overhead[tech] = overhead;
+                sc->rows[sample].bytes_per_key[tech] = (double)bytes / (double)stored;
+            }
+            if (perf_enabled) {
+                long counts[NUM_PERF_SLOTS];
+                perf_group_read(&perf, counts);
+                sc->rows[sample].l1_misses[tech] = counts[PERF_SLOT_L1];
+                sc->rows[sample].llc_misses[tech] = counts[PERF_SLOT_LLC];
+                sc->rows[sample].branch_misses[tech] = counts[PERF_SLOT_BRANCH];
+                sc->rows[sample].cycles[tech] = counts[PERF_SLOT_CYCLES];
+            }
+            if (shm_header != NULL) {
+                shm_ring_publish(sc, tech, &sc->rows[sample]);
+            }
+            sample++;
+        }
+
+        // Interleave the lookup/delete phases of the mixed workload,
+        // each class timed as its own batch.
+        if (mixed && (batch_end + 1) % workload_insert == 0) {
+            int found;
+            start_ns = monotonic_ns();
+            for (int l = 0; l < workload_lookup; l++) {
+                uint64_t target = sc->keys[workload_pick((unsigned int)(batch_end + l), (unsigned int)(batch_end + 1))];
+                if (l & 1) { target = ~target; } // absent key on odd picks
+                if (target >= DELETED_SLOT) { target -= 2; }
+                total_lookup_probes += driver_lookup(ctx, tech, target, &found);
+            }
+            total_lookup_ns += monotonic_ns() - start_ns;
+
+            start_ns = monotonic_ns();
+            for (int d = 0; d < workload_delete; d++) {
+                uint64_t target = sc->keys[workload_pick((unsigned int)(batch_end * 31 + d), (unsigned int)(batch_end + 1))];
+                total_delete_probes += driver_delete(ctx, tech, target, &found);
+            }
+            total_delete_ns += monotonic_ns() - start_ns;
+        }
+
+        i = batch_end + 1;
+    }
+
+    if (perf_enabled) { perf_group_close(&perf); }
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double da = *(const double*)a, db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+// Runs one (scenario, technique) cell under the repetition harness:
+// bench_warmup discarded runs, then bench_reps recorded runs whose
+// timing columns are aggregated. Probe counts are deterministic per
+// seed, so the last run's values stand for all of them.
+void run_technique_cell(Scenario *sc, Technique tech, TableCtx *ctx) {
+    for (int w = 0; w < bench_warmup; w++) {
+        run_technique(sc, tech, ctx);
+    }
+    if (bench_reps <= 1) {
+        run_technique(sc, tech, ctx);
+        for (int s = 0; s < sc->num_samples; s++) {
+            sc->rows[s].ns_per_op_median[tech] = sc->rows[s].ns_per_op[tech];
+            sc->rows[s].ns_per_op_p99[tech] = sc->rows[s].ns_per_op[tech];
+        }
+        return;
+    }
+
+    int n = sc->num_samples;
+    double *samples = (double*)malloc(sizeof(double) * (size_t)bench_reps * n);
+    double *time_sum = (double*)calloc(n * 5, sizeof(double));
+    if (samples == NULL || time_sum == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(1);
+    }
+
+    for (int r = 0; r < bench_reps; r++) {
+        run_technique(sc, tech, ctx);
+        for (int s = 0; s < n; s++) {
+            samples[(size_t)r * n + s] = sc->rows[s].ns_per_op[tech];
+            time_sum[s * 5 + 0] += sc->rows[s].time_ms[tech];
+            time_sum[s * 5 + 1] += sc->rows[s].ns_per_op[tech];
+            time_sum[s * 5 + 2] += sc->rows[s].lookup_time_ms[tech];
+            time_sum[s * 5 + 3] += sc->rows[s].delete_time_ms[tech];
+            time_sum[s * 5 + 4] += sc->rows[s].migration_time_ms[tech];
+        }
+    }
+
+    double *sorted = (double*)malloc(sizeof(double) * bench_reps);
+    if (sorted == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(1);
+    }
+    for (int s = 0; s < n; s++) {
+        double mean = time_sum[s * 5 + 1] / bench_reps;
+        double sumsq = 0.0;
+        for (int r = 0; r < bench_reps; r++) {
+            double v = samples[(size_t)r * n + s];
+            sorted[r] = v;
+            sumsq += (v - mean) * (v - mean);
+        }
+        qsort(sorted, bench_reps, sizeof(double), compare_doubles);
+
+        sc->rows[s].time_ms[tech] = time_sum[s * 5 + 0] / bench_reps;
+        sc->rows[s].ns_per_op[tech] = mean;
+        sc->rows[s].lookup_time_ms[tech] = time_sum[s * 5 + 2] / bench_reps;
+        sc->rows[s].delete_time_ms[tech] = time_sum[s * 5 + 3] / bench_reps;
+        sc->rows[s].migration_time_ms[tech] = time_sum[s * 5 + 4] / bench_reps;
+        sc->rows[s].ns_per_op_median[tech] = sorted[bench_reps / 2];
+        sc->rows[s].ns_per_op_p99[tech] = sorted[(bench_reps - 1) * 99 / 100];
+        sc->rows[s].ns_per_op_stddev[tech] = sqrt(sumsq / bench_reps);
+    }
+
+    free(sorted);
+    free(time_sum);
+    free(samples);
+}
+
+// --- Parallel Execution ---
+
+// One worker per (scenario, technique) combination.
+typedef struct {
+    Scenario *scenario;
+    Technique technique;
+} WorkerArgs;
+
+static void *worker_main(void *arg) {
+    WorkerArgs *w = (WorkerArgs*)arg;
+    TableCtx ctx = {0};
+    run_technique_cell(w->scenario, w->technique, &ctx);
+    table_ctx_cleanup(&ctx);
+    return NULL;
+}
+
+// --- Output ---
+
+static void print_csv_header(void) {
+    printf("Key_Index,Load_Factor,Scale,Distribution");
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Probes", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Time_ms", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_ns_per_op", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_ns_per_op_Median", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_ns_per_op_P99", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_ns_per_op_Stddev", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Probe_Max", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Probe_Var", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Lookup_Probes", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Lookup_Time_ms", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Miss_Probes_Avg", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Miss_Probes_Max", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Miss_ns_per_op", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Delete_Probes", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Delete_Time_ms", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Migration_Probes", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Migration_Time_ms", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Insert_Failures", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Stash_Hits", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Mem_Bytes", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Mem_Overhead", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Bytes_Per_Key", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_L1_Misses", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_LLC_Misses", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Branch_Misses", technique_names[t]);
+    }
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        printf(",%s_Cycles", technique_names[t]);
+    }
+    printf(",Page_Mode");
+    printf("\n");
+}
+
+static void print_scenario_rows(const Scenario *sc) {
+    for (int s = 0; s < sc->num_samples; s++) {
+        const SampleRow *row = &sc->rows[s];
+        printf("%ld,%.6f,%s,%s",
+               row->key_index,
+               row->load_factor,
+               sc->scale_name,
+               sc->distribution_name);
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->probes[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.6f", row->time_ms[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.2f", row->ns_per_op[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.2f", row->ns_per_op_median[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.2f", row->ns_per_op_p99[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.2f", row->ns_per_op_stddev[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->probe_max[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.3f", row->probe_var[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->lookup_probes[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.6f", row->lookup_time_ms[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.2f", row->miss_probes_avg[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->miss_probes_max[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.2f", row->miss_ns_per_op[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->delete_probes[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.6f", row->delete_time_ms[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->migration_probes[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.6f", row->migration_time_ms[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->insert_failures[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->stash_hits[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->mem_bytes[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->mem_overhead[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%.2f", row->bytes_per_key[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->l1_misses[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->llc_misses[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->branch_misses[t]);
+        }
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            printf(",%ld", row->cycles[t]);
+        }
+        printf(",%s", page_config_name());
+        printf("\n");
+    }
+}
+
+// --- Binary Output ---
+
+// Packed record format: a fixed-width header naming the techniques,
+// then one fixed-width record per sample row, written in large fwrite
+// batches. Avoids per-row printf formatting on big sweeps and lets the
+// Python side memory-map the file instead of parsing CSV text.
+#define BIN_MAGIC "HTBR"
+#define BIN_VERSION 13
+#define BIN_NAME_LEN 32
+
+typedef struct __attribute__((packed)) {
+    char magic[4];
+    uint32_t version;
+    uint32_t num_techniques;
+    uint32_t record_size;
+} BinHeader;
+
+typedef struct __attribute__((packed)) {
+    int64_t key_index;
+    double load_factor;
+    char scale[16]; // sweep names like "Size_1048576" overflow 8 bytes
+    char distribution[16];
+    int64_t probes[NUM_TECHNIQUES];
+    double time_ms[NUM_TECHNIQUES];
+    double ns_per_op[NUM_TECHNIQUES];
+    double ns_per_op_median[NUM_TECHNIQUES];
+    double ns_per_op_p99[NUM_TECHNIQUES];
+    double ns_per_op_stddev[NUM_TECHNIQUES];
+    int64_t probe_max[NUM_TECHNIQUES];
+    double probe_var[NUM_TECHNIQUES];
+    int64_t lookup_probes[NUM_TECHNIQUES];
+    double lookup_time_ms[NUM_TECHNIQUES];
+    double miss_probes_avg[NUM_TECHNIQUES];
+    int64_t miss_probes_max[NUM_TECHNIQUES];
+    double miss_ns_per_op[NUM_TECHNIQUES];
+    int64_t delete_probes[NUM_TECHNIQUES];
+    double delete_time_ms[NUM_TECHNIQUES];
+    int64_t migration_probes[NUM_TECHNIQUES];
+    double migration_time_ms[NUM_TECHNIQUES];
+    int64_t insert_failures[NUM_TECHNIQUES];
+    int64_t stash_hits[NUM_TECHNIQUES];
+    int64_t mem_bytes[NUM_TECHNIQUES];
+    int64_t mem_overhead[NUM_TECHNIQUES];
+    double bytes_per_key[NUM_TECHNIQUES];
+    int64_t l1_misses[NUM_TECHNIQUES];
+    int64_t llc_misses[NUM_TECHNIQUES];
+    int64_t branch_misses[NUM_TECHNIQUES];
+    int64_t cycles[NUM_TECHNIQUES];
+    char page_mode[16];
+} BinRecord;
+
+// Long-format probe-length histogram sidecar (--hist-out): one row per
+// non-empty bucket per (sample window, technique). Kept out of the
+// main CSV so its 264 columns don't grow by another few thousand;
+// app.py joins on Scale/Distribution/Key_Index to draw percentile
+// bands and CCDFs.
+static void write_hist_output(const char *path, Scenario *scenarios, int num_scenarios) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Cannot open %s for writing.\n", path);
+        exit(1);
+    }
+    fprintf(out, "Scale,Distribution,Load_Factor,Key_Index,Technique,Probe_Len,Count\n");
+    for (int s = 0; s < num_scenarios; s++) {
+        const Scenario *sc = &scenarios[s];
+        for (int r = 0; r < sc->num_samples; r++) {
+            const SampleRow *row = &sc->rows[r];
+            for (int t = 0; t < NUM_TECHNIQUES; t++) {
+                if (!(technique_mask & (1u << t))) { continue; }
+                for (int b = 0; b < PROBE_HIST_BUCKETS; b++) {
+                    if (row->probe_hist[t][b] == 0) { continue; }
+                    fprintf(out, "%s,%s,%.6f,%ld,%s,%d,%ld\n",
+                            sc->scale_name, sc->distribution_name,
+                            row->load_factor, row->key_index,
+                            technique_names[t], b, row->probe_hist[t][b]);
+                }
+            }
+        }
+    }
+    fclose(out);
+}
+
+// --- Regression Gate (--regress-baseline / --regress) ---
+
+// Turns the engine into a deploy gate: --regress-baseline runs a
+// pinned suite (seed 1, the built-in Micro/Macro matrix) and writes a
+// machine-readable baseline; --regress reruns the identical suite and
+// compares probe counts cell-by-cell (they are deterministic, so any
+// difference is a real behavior change) while timing is judged as the
+// geometric mean of the per-cell ns/op ratio across each technique's
+// amortized cells, which individual scheduler hiccups cannot tip over
+// --regress-tolerance. Failures print a diff to stderr and the process
+// exits nonzero. The suite is deterministic, so cells are compared in
+// emission order and any identity mismatch means the technique or
+// distribution matrix itself drifted — also a failure.
+static const char *regress_baseline_out = NULL;
+static const char *regress_path = NULL;
+static double regress_tolerance = 0.10; // relative ns/op noise budget
+
+static void regress_write(const char *path, Scenario *scenarios, int num_scenarios) {
+    FILE *out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Cannot open %s for writing.\n", path);
+        exit(1);
+    }
+    fprintf(out, "Scale,Distribution,Key_Index,Technique,Probes,ns_per_op\n");
+    for (int s = 0; s < num_scenarios; s++) {
+        const Scenario *sc = &scenarios[s];
+        for (int r = 0; r < sc->num_samples; r++) {
+            const SampleRow *row = &sc->rows[r];
+            for (int t = 0; t < NUM_TECHNIQUES; t++) {
+                if (!(technique_mask & (1u << t))) { continue; }
+                fprintf(out, "%s,%s,%ld,%s,%ld,%.6f\n",
+                        sc->scale_name, sc->distribution_name, row->key_index,
+                        technique_names[t], row->probes[t], row->ns_per_op[t]);
+            }
+        }
+    }
+    fclose(out);
+}
+
+static int regress_compare(const char *path, Scenario *scenarios, int num_scenarios) {
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        fprintf(stderr, "Cannot open baseline %s.\n", path);
+        exit(1);
+    }
+    char line[256];
+    if (fgets(line, sizeof(line), in) == NULL ||
+        strncmp(line, "Scale,Distribution,Key_Index,Technique,Probes", 45) != 0) {
+        fprintf(stderr, "%s is not a regression baseline.\n", path);
+        exit(1);
+    }
+
+    long cells = 0;
+    long probe_fails = 0;
+    long timing_fails = 0;
+    long structure_fails = 0;
+    double timing_log_sum[NUM_TECHNIQUES] = {0};
+    long timing_cells[NUM_TECHNIQUES] = {0};
+
+    for (int s = 0; s < num_scenarios; s++) {
+        const Scenario *sc = &scenarios[s];
+        for (int r = 0; r < sc->num_samples; r++) {
+            const SampleRow *row = &sc->rows[r];
+            for (int t = 0; t < NUM_TECHNIQUES; t++) {
+                if (!(technique_mask & (1u << t))) { continue; }
+                char scale[16], dist[24], tech[32];
+                long key_index, base_probes;
+                double base_ns;
+                if (fgets(line, sizeof(line), in) == NULL ||
+                    sscanf(line, "%15[^,],%23[^,],%ld,%31[^,],%ld,%lf",
+                           scale, dist, &key_index, tech,
+                           &base_probes, &base_ns) != 6) {
+                    fprintf(stderr, "REGRESSION %s: baseline ended early; "
+                                    "the suite grew since it was written.\n", path);
+                    fclose(in);
+                    return 1;
+                }
+                cells++;
+                if (strcmp(scale, sc->scale_name) != 0 ||
+                    strcmp(dist, sc->distribution_name) != 0 ||
+                    key_index != row->key_index ||
+                    strcmp(tech, technique_names[t]) != 0) {
+                    fprintf(stderr, "REGRESSION cell mismatch: baseline %s/%s key %ld %s, "
+                                    "run %s/%s key %ld %s\n",
+                            scale, dist, key_index, tech,
+                            sc->scale_name, sc->distribution_name,
+                            row->key_index, technique_names[t]);
+                    structure_fails++;
+                    continue;
+                }
+                if (row->probes[t] != base_probes) {
+                    fprintf(stderr, "REGRESSION %s/%s key %ld %s: probes %ld -> %ld (%+.2f%%)\n",
+                            scale, dist, key_index, tech, base_probes, row->probes[t],
+                            base_probes != 0
+                                ? 100.0 * (double)(row->probes[t] - base_probes) / (double)base_probes
+                                : 0.0);
+                    probe_fails++;
+                }
+                // Timing only feeds the geomean on well-amortized
+                // cells; below ~1000 inserts ns/op is dominated by
+                // timer quantization and scheduler noise, not the code.
+                if (key_index >= 1000 && base_ns > 0.0 &&
+                    row->ns_per_op[t] > 0.0) {
+                    timing_log_sum[t] += log(row->ns_per_op[t] / base_ns);
+                    timing_cells[t]++;
+                }
+            }
+        }
+    }
+    if (fgets(line, sizeof(line), in) != NULL) {
+        fprintf(stderr, "REGRESSION %s: baseline has extra cells; "
+                        "the suite shrank since it was written.\n", path);
+        structure_fails++;
+    }
+    fclose(in);
+
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        if (timing_cells[t] == 0) { continue; }
+        double ratio = exp(timing_log_sum[t] / (double)timing_cells[t]);
+        if (ratio > 1.0 + regress_tolerance) {
+            fprintf(stderr, "REGRESSION %s: ns/op geomean ratio %.3f over %ld cells "
+                            "(%+.1f%% > %.0f%% tolerance)\n",
+                    technique_names[t], ratio, timing_cells[t],
+                    100.0 * (ratio - 1.0), 100.0 * regress_tolerance);
+            timing_fails++;
+        }
+    }
+
+    long fails = probe_fails + timing_fails + structure_fails;
+    fprintf(stderr, "Regression gate: %ld cells, %ld probe mismatches, "
+                    "%ld timing violations, %ld structure mismatches -> %s\n",
+            cells, probe_fails, timing_fails, structure_fails,
+            fails == 0 ? "PASS" : "FAIL");
+    return fails != 0;
+}
+
+static void write_binary_output(const char *path, Scenario *scenarios, int num_scenarios) {
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "Cannot open %s for writing.\n", path);
+        exit(1);
+    }
+
+    BinHeader header;
+    memcpy(header.magic, BIN_MAGIC, 4);
+    header.version = BIN_VERSION;
+    header.num_techniques = NUM_TECHNIQUES;
+    header.record_size = sizeof(BinRecord);
+    fwrite(&header, sizeof(header), 1, out);
+
+    for (int t = 0; t < NUM_TECHNIQUES; t++) {
+        char name[BIN_NAME_LEN] = {0};
+        strncpy(name, technique_names[t], BIN_NAME_LEN - 1);
+        fwrite(name, BIN_NAME_LEN, 1, out);
+    }
+
+    for (int s = 0; s < num_scenarios; s++) {
+        const Scenario *sc = &scenarios[s];
+        BinRecord *batch = (BinRecord*)calloc(sc->num_samples, sizeof(BinRecord));
+        if (batch == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(1);
+        }
+        for (int r = 0; r < sc->num_samples; r++) {
+            const SampleRow *row = &sc->rows[r];
+            BinRecord *rec = &batch[r];
+            rec->key_index = row->key_index;
+            rec->load_factor = row->load_factor;
+            strncpy(rec->scale, sc->scale_name, sizeof(rec->scale) - 1);
+            strncpy(rec->distribution, sc->distribution_name, sizeof(rec->distribution) - 1);
+            for (int t = 0; t < NUM_TECHNIQUES; t++) {
+                rec->probes[t] = row->probes[t];
+                rec->time_ms[t] = row->time_ms[t];
+                rec->ns_per_op[t] = row->ns_per_op[t];
+                rec->ns_per_op_median[t] = row->ns_per_op_median[t];
+                rec->ns_per_op_p99[t] = row->ns_per_op_p99[t];
+                rec->ns_per_op_stddev[t] = row->ns_per_op_stddev[t];
+                rec->probe_max[t] = row->probe_max[t];
+                rec->probe_var[t] = row->probe_var[t];
+                rec->lookup_probes[t] = row->lookup_probes[t];
+                rec->lookup_time_ms[t] = row->lookup_time_ms[t];
+                rec->miss_probes_avg[t] = row->miss_probes_avg[t];
+                rec->miss_probes_max[t] = row->miss_probes_max[t];
+                rec->miss_ns_per_op[t] = row->miss_ns_per_op[t];
+                rec->delete_probes[t] = row->delete_probes[t];
+                rec->delete_time_ms[t] = row->delete_time_ms[t];
+                rec->migration_probes[t] = row->migration_probes[t];
+                rec->migration_time_ms[t] = row->migration_time_ms[t];
+                rec->insert_failures[t] = row->insert_failures[t];
+                rec->stash_hits[t] = row->stash_hits[t];
+                rec->mem_bytes[t] = row->mem_bytes[t];
+                rec->mem_overhead[t] = row->mem_overhead[t];
+                rec->bytes_per_key[t] = row->bytes_per_key[t];
+                rec->l1_misses[t] = row->l1_misses[t];
+                rec->llc_misses[t] = row->llc_misses[t];
+                rec->branch_misses[t] = row->branch_misses[t];
+                rec->cycles[t] = row->cycles[t];
+            }
+            snprintf(rec->page_mode, sizeof(rec->page_mode), "%s", page_config_name());
+        }
+        fwrite(batch, sizeof(BinRecord), sc->num_samples, out);
+        free(batch);
+    }
+
+    fclose(out);
+}
+
+// --- Concurrent Mode (--concurrent) ---
+
+// Single-threaded probe curves say nothing about contention collapse,
+// so this mode hammers ONE shared table from N inserter threads in
+// three flavors: chaining guarded by per-stripe mutexes, CAS-based
+// linear probing on the slot array, and lock-free CAS head insertion
+// on the chains. Like --hash-bench it prints its own narrow CSV (with
+// a Threads column to facet on) and exits; the wide SampleRow schema
+// stays single-threaded-per-table.
+
+typedef enum {
+    CONC_STRIPED = 0,
+    CONC_CAS_OPEN,
+    CONC_CAS_CHAIN,
+    NUM_CONC_FLAVORS
+} ConcFlavor;
+
+static const char *conc_flavor_names[NUM_CONC_FLAVORS] = {
+    "Striped_Chaining", "CAS_Linear", "CAS_Chaining"
+};
+
+#define CONC_STRIPES 64
+
+typedef struct {
+    // Shared table state (one copy per run, all workers point at it).
+    uint64_t *slots;
+    Node **heads;
+    pthread_mutex_t *stripes;
+    size_t table_size;
+    int flavor;
+    const uint64_t *keys;
+    long begin, end; // this worker's contiguous slice of the key stream
+    pthread_barrier_t *barrier;
+    Arena arena;    // thread-local, so node allocation never contends
+    long probes;    // slots examined or CAS attempts, summed by the driver
+} ConcWorker;
+
+static void *conc_worker_main(void *arg) {
+    ConcWorker *w = (ConcWorker*)arg;
+    long probes = 0;
+
+    pthread_barrier_wait(w->barrier);
+    for (long i = w->begin; i < w->end; i++) {
+        uint64_t key = w->keys[i];
+        // All flavors share one fixed mixer so contention, not hash
+        // quality, is the variable under test.
+        size_t bucket = (size_t)(cuckoo_mix(key, 0u) % (uint64_t)w->table_size);
+
+        if (w->flavor == CONC_CAS_OPEN) {
+            size_t pos = bucket;
+            for (;;) {
+                probes++;
+                uint64_t expected = EMPTY_SLOT;
+                if (__atomic_compare_exchange_n(&w->slots[pos], &expected, key, 0,
+                                                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                    break;
+                }
+                pos++;
+                if (pos == w->table_size) { pos = 0; }
+            }
+        } else {
+            Node *node = arena_alloc_node(&w->arena);
+            if (node == NULL) { break; }
+            node->key = key;
+            if (w->flavor == CONC_STRIPED) {
+                probes++;
+                pthread_mutex_t *stripe = &w->stripes[bucket & (CONC_STRIPES - 1)];
+                pthread_mutex_lock(stripe);
+                node->next = w->heads[bucket];
+                w->heads[bucket] = node;
+                pthread_mutex_unlock(stripe);
+            } else {
+                Node *head = __atomic_load_n(&w->heads[bucket], __ATOMIC_RELAXED);
+                do {
+                    probes++;
+                    node->next = head;
+                } while (!__atomic_compare_exchange_n(&w->heads[bucket], &head, node, 0,
+                                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+            }
+        }
+    }
+    w->probes = probes;
+    return NULL;
+}
+
+// --- Hash Micro-Benchmark (--hash-bench) ---
+
+// Reports, per hash kind, standalone hashing throughput and the
+// chi-square of the bucket distribution for a uniform-ish stream and
+// for the Worst_Case generator stream. Separates hash quality from
+// collision-policy quality: a high chi-square means the collisions the
+// techniques fight are manufactured by the hash, not the policy.
+static double bucket_chi_square(const TableCtx *ctx, int num_keys, int worst_case) {
+    int buckets = ctx->table_size;
+    long *counts = (long*)calloc(buckets, sizeof(long));
+    if (counts == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(1);
+    }
+
+    for (long i = 0; i < num_keys; i++) {
+        uint64_t key = worst_case ? generate_worst_case_key(NULL, i)
+                                  : (uint64_t)i * 0x9e3779b97f4a7c15ull;
+        counts[hash1(ctx, key)]++;
+    }
+
+    double expected = (double)num_keys / buckets;
+    double chi2 = 0.0;
+    for (int b = 0; b < buckets; b++) {
+        double d = (double)counts[b] - expected;
+        chi2 += d * d / expected;
+    }
+    free(counts);
+    return chi2;
+}
+
+static void run_hash_bench(void) {
+    const int bench_keys = 1 << 22;
+    const int bench_buckets = 4096;
+    TableCtx bench_ctx = {0};
+    bench_ctx.table_size = bench_buckets;
+
+    printf("Hash,ns_per_hash,Chi_Square_Uniform,Chi_Square_Worst_Case\n");
+    for (int h = 0; h < NUM_HASH_KINDS; h++) {
+        hash_kind = h;
+
+        // Throughput: the volatile sink keeps the loop from being
+        // optimized away.
+        volatile int sink = 0;
+        uint64_t start_ns = monotonic_ns();
+        for (int i = 0; i < bench_keys; i++) {
+            sink += hash1(&bench_ctx, (int)((unsigned int)i * 2654435761u));
+        }
+        double ns_per_hash = (double)(monotonic_ns() - start_ns) / bench_keys;
+
+        double chi2_uniform = bucket_chi_square(&bench_ctx, bench_keys, 0);
+        double chi2_worst = bucket_chi_square(&bench_ctx, bench_keys, 1);
+
+        printf("%s,%.3f,%.1f,%.1f\n",
+               hash_kind_names[h], ns_per_hash, chi2_uniform, chi2_worst);
+    }
+}
+
+// --- Command Line ---
+
+// Maximum table sizes accepted by --table-size (sweep mode).
+#define MAX_SWEEP_SIZES 64
+
+typedef struct {
+    int parallel;
+    const char *binary_out;
+    size_t table_sizes[MAX_SWEEP_SIZES];
+    int num_table_sizes;     // 0 = built-in Micro/Macro scenario set
+    long num_keys;           // 0 = one key per slot
+    unsigned int dist_mask;  // bit per entry in distributions[]
+    const char *trace_path;  // NULL = synthetic generators
+    int hash_bench;
+    int concurrent;
+    int thread_counts[16];
+    int num_thread_counts;
+} Config;
+
+static void run_concurrent(const Config *cfg) {
+    size_t size = cfg->num_table_sizes > 0 ? cfg->table_sizes[0] : (size_t)TABLE_SIZE;
+    long num_keys = cfg->num_keys > 0 ? cfg->num_keys : (long)(size / 2);
+    if ((size_t)num_keys > size / 10 * 9) {
+        // CAS linear probing must never fill the table or the last
+        // inserts spin forever.
+        num_keys = (long)(size / 10 * 9);
+        fprintf(stderr, "Clamping --keys to %ld (90%% of %zu slots) for the CAS open-addressing flavor.\n",
+                num_keys, size);
+    }
+
+    uint64_t *keys = (uint64_t*)malloc(sizeof(uint64_t) * num_keys);
+    if (keys == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(1);
+    }
+    Rng rng;
+    rng_init(&rng, rng_seed, 0);
+    for (long i = 0; i < num_keys; i++) {
+        keys[i] = generate_uniform_key(&rng, i);
+    }
+
+    printf("Threads,Flavor,Table_Size,Keys,Total_Probes,Time_ms,Inserts_Per_Sec\n");
+
+    for (int tc = 0; tc < cfg->num_thread_counts; tc++) {
+        int nthreads = cfg->thread_counts[tc];
+        for (int flavor = 0; flavor < NUM_CONC_FLAVORS; flavor++) {
+            uint64_t *slots = (uint64_t*)malloc(sizeof(uint64_t) * size);
+            Node **heads = (Node**)calloc(size, sizeof(Node*));
+            pthread_mutex_t *stripes = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t) * CONC_STRIPES);
+            ConcWorker *workers = (ConcWorker*)calloc(nthreads, sizeof(ConcWorker));
+            pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * nthreads);
+            if (slots == NULL || heads == NULL || stripes == NULL ||
+                workers == NULL || threads == NULL) {
+                fprintf(stderr, "Memory allocation failed.\n");
+                exit(1);
+            }
+            for (size_t i = 0; i < size; i++) { slots[i] = EMPTY_SLOT; }
+            for (int s = 0; s < CONC_STRIPES; s++) { pthread_mutex_init(&stripes[s], NULL); }
+
+            pthread_barrier_t barrier;
+            pthread_barrier_init(&barrier, NULL, (unsigned int)nthreads + 1);
+
+            long per_thread = num_keys / nthreads;
+            for (int w = 0; w < nthreads; w++) {
+                workers[w].slots = slots;
+                workers[w].heads = heads;
+                workers[w].stripes = stripes;
+                workers[w].table_size = size;
+                workers[w].flavor = flavor;
+                workers[w].keys = keys;
+                workers[w].begin = w * per_thread;
+                workers[w].end = (w == nthreads - 1) ? num_keys : (w + 1) * per_thread;
+                workers[w].barrier = &barrier;
+                if (pthread_create(&threads[w], NULL, conc_worker_main, &workers[w]) != 0) {
+                    fprintf(stderr, "Thread creation failed.\n");
+                    exit(1);
+                }
+            }
+
+            // The clock must start before the main thread arrives at
+            // the barrier: its arrival is what releases the workers,
+            // so a timestamp taken afterwards races them.
+            uint64_t start_ns = monotonic_ns();
+            pthread_barrier_wait(&barrier);
+            long total_probes = 0;
+            for (int w = 0; w < nthreads; w++) {
+                pthread_join(threads[w], NULL);
+                total_probes += workers[w].probes;
+            }
+            uint64_t elapsed_ns = monotonic_ns() - start_ns;
+
+            double time_ms = (double)elapsed_ns / 1e6;
+            double per_sec = (double)num_keys / ((double)elapsed_ns / 1e9);
+            printf("%d,%s,%zu,%ld,%ld,%.3f,%.0f\n",
+                   nthreads, conc_flavor_names[flavor], size, num_keys,
+                   total_probes, time_ms, per_sec);
+
+            for (int w = 0; w < nthreads; w++) { arena_release(&workers[w].arena); }
+            for (int s = 0; s < CONC_STRIPES; s++) { pthread_mutex_destroy(&stripes[s]); }
+            pthread_barrier_destroy(&barrier);
+            free(threads);
+            free(workers);
+            free(stripes);
+            free(heads);
+            free(slots);
+        }
+    }
+    free(keys);
+}
+
+static void print_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --parallel              run each (scenario, technique) cell on its own thread\n"
+            "  --binary-out FILE       write packed binary records instead of CSV\n"
+            "  --table-size N[,N...]   table slot counts to sweep (default: built-in Micro/Macro)\n"
+            "  --keys N                insertions per run (default: one per slot)\n"
+            "  --steps N               sample checkpoints per run (default: %d)\n"
+            "  --distributions LIST    comma list of Uniform,Skewed,Worst_Case (default: all)\n"
+            "  --trace FILE            replay a binary key trace (little-endian uint64 per key)\n"
+            "                          instead of the synthetic distributions\n"
+            "  --techniques LIST       comma list of technique names (default: all)\n"
+            "  --workload I:L:D        mixed workload: per I inserts do L lookups and D deletes\n"
+            "                          (default 1:0:0, pure insert)\n"
+            "  --grow-at ALPHA         double the table when live load factor crosses ALPHA\n"
+            "  --grow-mode MODE        rehash mode: stw (default) or incremental\n"
+            "  --migrate-buckets N     old buckets moved per insert in incremental mode (default 8)\n"
+            "  --hash NAME             hash function: Modulo, Multiplicative, Murmur, XXMix\n"
+            "  --seed N                PRNG seed for key generation (default 1); identical\n"
+            "                          seeds reproduce identical key streams\n"
+            "  --hash-bench            benchmark the hash suite (throughput, chi-square) and exit\n"
+            "  --concurrent            shared-table insert benchmark (striped locks, CAS open\n"
+            "                          addressing, CAS chaining); prints Threads-faceted CSV\n"
+            "  --threads N[,N...]      inserter thread counts for --concurrent (default 1,2,4,8)\n"
+            "  --reps N                recorded repetitions per cell; timing columns hold the\n"
+            "                          mean and ns/op gains median/p99/stddev columns\n"
+            "  --warmup M              discarded warm-up runs before the recorded ones\n"
+            "  --perf                  record hardware counters (L1/LLC misses, branch misses,\n"
+            "                          cycles) around insert batches via perf_event_open\n"
+            "  --regress-baseline FILE run the pinned suite and write a baseline\n"
+            "  --regress FILE          rerun the pinned suite against a baseline: probe\n"
+            "                          counts must match exactly, ns/op within tolerance;\n"
+            "                          nonzero exit with a per-cell diff on failure\n"
+            "  --regress-tolerance T   relative ns/op noise budget for --regress\n"
+            "                          (default 0.10)\n"
+            "  --pages MODE            table array backing: malloc (default), thp\n"
+            "                          (transparent huge pages), hugetlb (explicit 2MB pages,\n"
+            "                          thp fallback); recorded in the Page_Mode column\n"
+            "  --numa interleave       interleave table arrays across NUMA nodes via mbind\n"
+            "  --batch-size N          keys hashed/prefetched per group by the batched\n"
+            "                          variant (default 8, max 64)\n"
+            "  --zipf-s S              Zipf exponent for the Zipf distribution (default 0.99)\n"
+            "  --burst-len N           run length for the Clustered distribution (default 16)\n"
+            "  --hist-out FILE         per-window probe-length histograms as a long-format\n"
+            "                          CSV sidecar for percentile/CCDF plots\n"
+            "  --shm-out NAME          publish sample records live into the named POSIX\n"
+            "                          shared-memory ring so the dashboard can attach mid-run\n"
+            "  --checkpoint-out FILE   dump per-technique table state once the load factor\n"
+            "                          reaches --checkpoint-at (default 1.0)\n"
+            "  --checkpoint-at LF      load factor that triggers the checkpoint dump\n"
+            "  --restore FILE          resume each technique from a checkpoint instead of\n"
+            "                          replaying the prior inserts (same --seed required)\n",
+            prog, LOAD_FACTOR_STEPS);
+}
+
+static int parse_size_list(const char *arg, size_t *out, int max) {
+    int count = 0;
+    char *copy = strdup(arg);
+    if (copy == NULL) { return -1; }
+    for (char *tok = strtok(copy, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        long long value = atoll(tok);
+        if (value <= 0 || count == max) { free(copy); return -1; }
+        out[count++] = (size_t)value;
+    }
+    free(copy);
+    return count;
+}
+
+// Builds a bitmask by matching comma-separated names against a name
+// table; returns 0 on an unrecognized name.
+static unsigned int parse_name_mask(const char *arg, const char *const *names, int num_names) {
+    unsigned int mask = 0;
+    char *copy = strdup(arg);
+    if (copy == NULL) { return 0; }
+    for (char *tok = strtok(copy, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        int matched = 0;
+        for (int n = 0; n < num_names; n++) {
+            if (strcmp(tok, names[n]) == 0) {
+                mask |= 1u << n;
+                matched = 1;
+                break;
+            }
+        }
+        if (!matched) {
+            fprintf(stderr, "Unknown name: %s\n", tok);
+            free(copy);
+            return 0;
+        }
+    }
+    free(copy);
+    return mask;
+}
+
+static int parse_args(int argc, char *argv[], Config *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->dist_mask = (1u << NUM_DISTRIBUTIONS) - 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--parallel") == 0) {
+            cfg->parallel = 1;
+        } else if (strcmp(argv[i], "--binary-out") == 0 && i + 1 < argc) {
+            cfg->binary_out = argv[++i];
+        } else if (strcmp(argv[i], "--table-size") == 0 && i + 1 < argc) {
+            cfg->num_table_sizes = parse_size_list(argv[++i], cfg->table_sizes, MAX_SWEEP_SIZES);
+            if (cfg->num_table_sizes <= 0) {
+                fprintf(stderr, "Invalid --table-size list: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--keys") == 0 && i + 1 < argc) {
+            cfg->num_keys = atol(argv[++i]);
+            if (cfg->num_keys <= 0) {
+                fprintf(stderr, "Invalid --keys value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            load_factor_steps = atoi(argv[++i]);
+            if (load_factor_steps <= 0) {
+                fprintf(stderr, "Invalid --steps value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--distributions") == 0 && i + 1 < argc) {
+            const char *names[NUM_DISTRIBUTIONS];
+            for (int d = 0; d < NUM_DISTRIBUTIONS; d++) { names[d] = distributions[d].name; }
+            cfg->dist_mask = parse_name_mask(argv[++i], names, NUM_DISTRIBUTIONS);
+            if (cfg->dist_mask == 0) { return -1; }
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            cfg->trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--techniques") == 0 && i + 1 < argc) {
+            technique_mask = parse_name_mask(argv[++i], technique_names, NUM_TECHNIQUES);
+            if (technique_mask == 0) { return -1; }
+        } else if (strcmp(argv[i], "--hash") == 0 && i + 1 < argc) {
+            i++;
+            int matched = 0;
+            for (int h = 0; h < NUM_HASH_KINDS; h++) {
+                if (strcmp(argv[i], hash_kind_names[h]) == 0) {
+                    hash_kind = h;
+                    matched = 1;
+                    break;
+                }
+            }
+            if (!matched) {
+                fprintf(stderr, "Unknown hash function: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--concurrent") == 0) {
+            cfg->concurrent = 1;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            size_t counts[sizeof(cfg->thread_counts) / sizeof(int)];
+            cfg->num_thread_counts = parse_size_list(argv[++i], counts,
+                                                     (int)(sizeof(counts) / sizeof(size_t)));
+            if (cfg->num_thread_counts <= 0) {
+                fprintf(stderr, "Invalid --threads list: %s\n", argv[i]);
+                return -1;
+            }
+            for (int n = 0; n < cfg->num_thread_counts; n++) {
+                cfg->thread_counts[n] = (int)counts[n];
+            }
+        } else if (strcmp(argv[i], "--regress-baseline") == 0 && i + 1 < argc) {
+            regress_baseline_out = argv[++i];
+        } else if (strcmp(argv[i], "--regress") == 0 && i + 1 < argc) {
+            regress_path = argv[++i];
+        } else if (strcmp(argv[i], "--regress-tolerance") == 0 && i + 1 < argc) {
+            regress_tolerance = atof(argv[++i]);
+            if (regress_tolerance <= 0.0) {
+                fprintf(stderr, "Invalid --regress-tolerance value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--pages") == 0 && i + 1 < argc) {
+            i++;
+            int matched = 0;
+            for (int m = 0; m < NUM_PAGE_MODES; m++) {
+                if (strcmp(argv[i], page_mode_names[m]) == 0) {
+                    page_mode = m;
+                    page_mode_effective = m;
+                    matched = 1;
+                    break;
+                }
+            }
+            if (!matched) {
+                fprintf(stderr, "Unknown --pages mode: %s (malloc, thp, hugetlb)\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--numa") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "interleave") != 0) {
+                fprintf(stderr, "Unknown --numa mode: %s (interleave)\n", argv[i]);
+                return -1;
+            }
+            numa_interleave = 1;
+        } else if (strcmp(argv[i], "--batch-size") == 0 && i + 1 < argc) {
+            batch_size = atoi(argv[++i]);
+            if (batch_size < 1 || batch_size > BATCH_MAX) {
+                fprintf(stderr, "Invalid --batch-size value: %s (1..%d)\n", argv[i], BATCH_MAX);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--zipf-s") == 0 && i + 1 < argc) {
+            zipf_s = atof(argv[++i]);
+            if (zipf_s <= 0.0) {
+                fprintf(stderr, "Invalid --zipf-s value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--burst-len") == 0 && i + 1 < argc) {
+            cluster_burst = atol(argv[++i]);
+            if (cluster_burst <= 0) {
+                fprintf(stderr, "Invalid --burst-len value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--hist-out") == 0 && i + 1 < argc) {
+            hist_out = argv[++i];
+        } else if (strcmp(argv[i], "--shm-out") == 0 && i + 1 < argc) {
+            shm_out_name = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-out") == 0 && i + 1 < argc) {
+            checkpoint_out = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-at") == 0 && i + 1 < argc) {
+            checkpoint_at = atof(argv[++i]);
+            if (checkpoint_at <= 0.0) {
+                fprintf(stderr, "Invalid --checkpoint-at value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--restore") == 0 && i + 1 < argc) {
+            restore_path = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--hash-bench") == 0) {
+            cfg->hash_bench = 1;
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            bench_reps = atoi(argv[++i]);
+            if (bench_reps <= 0) {
+                fprintf(stderr, "Invalid --reps value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            bench_warmup = atoi(argv[++i]);
+            if (bench_warmup < 0) {
+                fprintf(stderr, "Invalid --warmup value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            perf_enabled = 1;
+        } else if (strcmp(argv[i], "--grow-at") == 0 && i + 1 < argc) {
+            grow_at = atof(argv[++i]);
+            if (grow_at <= 0.0 || grow_at > 1.0) {
+                fprintf(stderr, "Invalid --grow-at threshold: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--grow-mode") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "stw") == 0) {
+                grow_incremental = 0;
+            } else if (strcmp(argv[i], "incremental") == 0) {
+                grow_incremental = 1;
+            } else {
+                fprintf(stderr, "Invalid --grow-mode: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--migrate-buckets") == 0 && i + 1 < argc) {
+            migrate_step = atoi(argv[++i]);
+            if (migrate_step <= 0) {
+                fprintf(stderr, "Invalid --migrate-buckets value: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--workload") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d:%d:%d", &workload_insert,
+                       &workload_lookup, &workload_delete) != 3 ||
+                workload_insert <= 0 || workload_lookup < 0 || workload_delete < 0) {
+                fprintf(stderr, "Invalid --workload ratio: %s\n", argv[i]);
+                return -1;
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Fills the scenario list from the config: either the built-in
+// Micro/Macro matrix or one scenario per (sweep size, distribution).
+// Returns the number of scenarios.
+static int build_scenarios(const Config *cfg, Scenario *scenarios, char (*sweep_names)[24]) {
+    int count = 0;
+
+    if (cfg->trace_path != NULL) {
+        // Trace replay: one scenario per table size, keys drawn from
+        // the mapping (scenario_prepare clamps to the trace length).
+        if (cfg->num_table_sizes == 0) {
+            scenarios[count] = (Scenario){ "Macro", "Trace", NULL, (uint64_t)count,
+                                           cfg->num_keys > 0 ? cfg->num_keys : NUM_INSERTIONS,
+                                           TABLE_SIZE, NULL, 0, 0, NULL };
+            count++;
+            return count;
+        }
+        for (int i = 0; i < cfg->num_table_sizes; i++) {
+            size_t size = cfg->table_sizes[i];
+            snprintf(sweep_names[i], sizeof(sweep_names[i]), "Size_%zu", size);
+            scenarios[count] = (Scenario){ sweep_names[i], "Trace", NULL, (uint64_t)count,
+                                           cfg->num_keys > 0 ? cfg->num_keys : (long)size,
+                                           size, NULL, 0, 0, NULL };
+            count++;
+        }
+        return count;
+    }
+
+    if (cfg->num_table_sizes == 0) {
+        // --- 1. Micro-Scale Simulations (10 Keys) ---
+        for (int d = 0; d < NUM_DISTRIBUTIONS; d++) {
+            if (!(cfg->dist_mask & (1u << d))) { continue; }
+            scenarios[count] = (Scenario){ "Micro", distributions[d].name, distributions[d].generator,
+                                           (uint64_t)count, MICRO_SIZE, MICRO_TABLE_SIZE, NULL, 0, 0, NULL };
+            count++;
+        }
+        // --- 2. Macro-Scale Simulations (10,000 Keys) ---
+        for (int d = 0; d < NUM_DISTRIBUTIONS; d++) {
+            if (!(cfg->dist_mask & (1u << d))) { continue; }
+            scenarios[count] = (Scenario){ "Macro", distributions[d].name, distributions[d].generator,
+                                           (uint64_t)count,
+                                           cfg->num_keys > 0 ? cfg->num_keys : NUM_INSERTIONS,
+                                           TABLE_SIZE, NULL, 0, 0, NULL };
+            count++;
+        }
+        return count;
+    }
+
+    for (int i = 0; i < cfg->num_table_sizes; i++) {
+        size_t size = cfg->table_sizes[i];
+        snprintf(sweep_names[i], sizeof(sweep_names[i]), "Size_%zu", size);
+        for (int d = 0; d < NUM_DISTRIBUTIONS; d++) {
+            if (!(cfg->dist_mask & (1u << d))) { continue; }
+            scenarios[count] = (Scenario){ sweep_names[i], distributions[d].name, distributions[d].generator,
+                                           (uint64_t)count,
+                                           cfg->num_keys > 0 ? cfg->num_keys : (long)size,
+                                           size, NULL, 0, 0, NULL };
+            count++;
+        }
+    }
+    return count;
+}
+
+int main(int argc, char *argv[]) {
+    Config cfg;
+    if (parse_args(argc, argv, &cfg) != 0) {
+        return 1;
+    }
+
+    select_probe_scan();
+    if (cfg.trace_path != NULL) { trace_open(cfg.trace_path); }
+
+    if (cfg.hash_bench) {
+        run_hash_bench();
+        return 0;
+    }
+    if (cfg.concurrent) {
+        if (cfg.num_thread_counts == 0) {
+            static const int default_threads[] = {1, 2, 4, 8};
+            memcpy(cfg.thread_counts, default_threads, sizeof(default_threads));
+            cfg.num_thread_counts = 4;
+        }
+        run_concurrent(&cfg);
+        return 0;
+    }
+
+    if (regress_baseline_out != NULL || regress_path != NULL) {
+        // Pinned suite: fixed seed and the built-in Micro/Macro matrix,
+        // so baselines stay comparable across builds and machines.
+        rng_seed = 1;
+        cfg.num_table_sizes = 0;
+        cfg.num_keys = 0;
+        cfg.trace_path = NULL;
+        cfg.dist_mask = (1u << NUM_DISTRIBUTIONS) - 1;
+    }
+
+    Scenario scenarios[MAX_SWEEP_SIZES * NUM_DISTRIBUTIONS];
+    char sweep_names[MAX_SWEEP_SIZES][24];
+    int num_scenarios = build_scenarios(&cfg, scenarios, sweep_names);
+
+    if ((checkpoint_out != NULL || restore_path != NULL) && num_scenarios != 1) {
+        fprintf(stderr, "--checkpoint-out/--restore need exactly one scenario; narrow the run\n"
+                        "with a single --table-size and --distributions entry.\n");
+        exit(1);
+    }
+    if (restore_path != NULL) { restore_open(restore_path); }
+    if (checkpoint_out != NULL) { ckpt_open(checkpoint_out); }
+    if (shm_out_name != NULL) { shm_ring_open(shm_out_name); }
+
+    // Each scenario draws from its own seeded sub-stream, so every
+    // technique sees the identical keys regardless of thread scheduling.
+    for (int s = 0; s < num_scenarios; s++) {
+        scenario_prepare(&scenarios[s]);
+    }
+
+    if (cfg.parallel) {
+        int num_workers = 0;
+        pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * num_scenarios * NUM_TECHNIQUES);
+        WorkerArgs *args = (WorkerArgs*)malloc(sizeof(WorkerArgs) * num_scenarios * NUM_TECHNIQUES);
+        if (threads == NULL || args == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(1);
+        }
+
+        for (int s = 0; s < num_scenarios; s++) {
+            for (int t = 0; t < NUM_TECHNIQUES; t++) {
+                if (!(technique_mask & (1u << t))) { continue; }
+                args[num_workers].scenario = &scenarios[s];
+                args[num_workers].technique = (Technique)t;
+                if (pthread_create(&threads[num_workers], NULL, worker_main, &args[num_workers]) != 0) {
+                    fprintf(stderr, "Thread creation failed.\n");
+                    exit(1);
+                }
+                num_workers++;
+            }
+        }
+        for (int w = 0; w < num_workers; w++) {
+            pthread_join(threads[w], NULL);
+        }
+
+        free(threads);
+        free(args);
+    } else {
+        // Technique-major order so each technique reuses one table
+        // context across every scenario in the sweep.
+        for (int t = 0; t < NUM_TECHNIQUES; t++) {
+            if (!(technique_mask & (1u << t))) { continue; }
+            TableCtx ctx = {0};
+            for (int s = 0; s < num_scenarios; s++) {
+                run_technique_cell(&scenarios[s], (Technique)t, &ctx);
+            }
+            table_ctx_cleanup(&ctx);
+        }
+    }
+
+    // Results are merged in scenario order regardless of which worker
+    // finished first, so the output is always ordered the same way.
+    // CSV on stdout stays the compatibility default; --binary-out
+    // writes the packed record format instead.
+    if (regress_baseline_out != NULL) {
+        regress_write(regress_baseline_out, scenarios, num_scenarios);
+        fprintf(stderr, "Regression baseline written to %s.\n", regress_baseline_out);
+    } else if (regress_path != NULL) {
+        if (regress_compare(regress_path, scenarios, num_scenarios)) {
+            for (int s = 0; s < num_scenarios; s++) {
+                scenario_release(&scenarios[s]);
+            }
+            return 1;
+        }
+    } else if (cfg.binary_out != NULL) {
+        write_binary_output(cfg.binary_out, scenarios, num_scenarios);
+    } else {
+        print_csv_header();
+        for (int s = 0; s < num_scenarios; s++) {
+            print_scenario_rows(&scenarios[s]);
+        }
+    }
+    if (hist_out != NULL) {
+        write_hist_output(hist_out, scenarios, num_scenarios);
+    }
+    for (int s = 0; s < num_scenarios; s++) {
+        scenario_release(&scenarios[s]);
+    }
+    trace_close();
 
     return 0;
 }